@@ -1,21 +1,128 @@
 #pragma once
 
-#include "album.h"
+#include "catalog.h"
+#include "curves.h"
+#include "genre.h"
 #include "player.h"
-#include "song.h"
 
-#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory>
+#include <utility>
 
+struct EventLog;
+class TelemetryRecorder;
+
+// NOTE: This header is part of the headless core (MusicTycoonCore) and must
+// stay free of SFML/ImGui. Time is passed around as plain seconds.
+
+// How one release's daily streams move the fanbase.
+struct FanbaseDelta {
+  int newFans = 0;       // Converted listeners, including any viral spike
+  int angryFans = 0;     // Backlash from very low quality
+  double repChange = 0.0;
+  int viralSpike = 0;    // > 0 if this release went viral (for the log)
+};
+
+// Pure version of UpdateFanbase: reads the fanbase, never writes it.
+FanbaseDelta EvaluateFanbase(int fans, double reputation, int streams,
+                             double songQuality, double hype,
+                             CurveMode curves);
+
+// EvaluateFanbase (with GetCurveMode()) + apply the delta to 'player'
+// immediately.
 void UpdateFanbase(Player &player, int streams, double songQuality,
                    double hype);
 
-std::pair<float, std::string_view>
-GetMarketTrend(std::shared_ptr<float> tickTimer);
+// --- PER-WORLD STATE ---
+// Everything the economy carries from one call to the next. Each independent
+// career (World) owns one. The overloads without an EconomyState share a
+// process-wide instance seeded from Random::GetSeed() and logging to gameLog
+// (the app's single career).
+
+// Current market trend and how many shifts happened so far.
+struct MarketState {
+  bool initialized = false;
+  float multiplier = 1.0f;
+  Genre genre = Genre::Pop;
+  uint64_t shiftCount = 0; // Keys the market RNG stream
+};
+
+struct EconomyState {
+  uint64_t seed = 0; // Keys every random stream drawn by the economy
+  MarketState market;
+  float accumulator = 0.0f; // Time since the last economy tick
+  uint64_t tick = 0;        // Economy ticks so far
+
+  // Optional per-tick recorder (not owned). nullptr = telemetry off.
+  TelemetryRecorder *telemetry = nullptr;
+};
+
+// Current trend bonus and trending genre.
+std::pair<float, Genre> GetMarketTrend(std::shared_ptr<float> tickTimer);
+
+// 'log' may be nullptr (messages are dropped).
+std::pair<float, Genre> GetMarketTrend(EconomyState &state, float &tickTimer,
+                                       EventLog *log);
+
+// Reputation a catalog earns: summed quality / 100, clamped to [0, 5].
+// O(1) (uses ReleaseCatalog::qualitySum). Builds with
+// MUSICTYCOON_CHECK_REPUTATION re-sum the catalogs on every call and abort
+// on a mismatch.
+double CatalogReputation(const ReleaseCatalog &songs,
+                         const ReleaseCatalog &albums);
+
+// 'telemetry' (optional) gets the new reputation whenever a cycle runs.
+bool UpdateReputation(Player &player, const ReleaseCatalog &songs,
+                      const ReleaseCatalog &albums,
+                      const std::shared_ptr<float> &deltaTimePtr,
+                      TelemetryRecorder *telemetry = nullptr);
+
+// Serial: releases update the player one after another (each sees the fans
+// and reputation left by the previous one).
+// Parallel: the catalogs are split into fixed-size chunks across the shared
+// thread pool. Every chunk reads the tick-start player, accumulates its own
+// revenue/fan/reputation deltas, and the chunks are merged in order at the
+// end of the tick, so results do not depend on the thread count.
+enum class TickMode { Serial, Parallel };
+
+void SimulateEconomy(ReleaseCatalog &songs, ReleaseCatalog &albums,
+                     Player &player, float dt,
+                     std::shared_ptr<float> tickTimer,
+                     TickMode mode = TickMode::Serial);
+
+// Same, for one world: state, clock and log are explicit, nothing global is
+// touched except the read-only SIMD level. 'log' may be nullptr.
+void SimulateEconomy(EconomyState &state, ReleaseCatalog &songs,
+                     ReleaseCatalog &albums, Player &player, float dt,
+                     float &clock, EventLog *log,
+                     TickMode mode = TickMode::Serial);
 
-bool UpdateReputation(Player &player, const std::vector<Song> &songs,
-                      const std::vector<Album> &albums,
-                      const std::shared_ptr<float> &deltaTimePtr);
+// --- ANALYTIC FAST-FORWARD ---
+// Advances the economy by up to 'maxTicks' whole ticks in one step. While
+// no release is near traction (1000 streams), can go viral or trigger
+// backlash, and the fanbase stays inside one churn band, every release's
+// hype and freshness decay geometrically, so its streams, sales and revenue
+// over the span have closed forms. The random terms (viral base, long tail,
+// fractional fans) are drawn once per release from their summed
+// distributions. Market shifts and scandals end a span (the next tick then
+// runs normally). Streams are computed for the fanbase and reputation at
+// the start of the span, so spans are also cut short when the fanbase would
+// move by more than a few percent.
+//
+// Same clock, tick counter and accumulator bookkeeping as 'ticks' calls to
+// SimulateEconomy with dt = ECONOMY_TICK_RATE; results match those calls in
+// distribution, not draw for draw. Nothing is logged. Returns the number of
+// ticks covered; 0 means a threshold could be crossed right now and the
+// caller should run one normal tick instead. Spans are at least 8 ticks
+// long, or 'maxTicks' if that is shorter (a week's skip is one span).
+uint64_t FastForwardEconomy(EconomyState &state, ReleaseCatalog &songs,
+                            ReleaseCatalog &albums, Player &player,
+                            uint64_t maxTicks, float &clock);
 
-void SimulateEconomy(std::vector<Song> &songs, std::vector<Album> &albums,
-                     Player &player, sf::Time dt,
-                     std::shared_ptr<float> tickTimer);
+// --- RELEASE FORECAST ---
+// Mean lifetime earnings of an album of 'quality' released now at the
+// recommended price: SimulateRange's per-tick model along its expected path
+// (viral base at its mean, long tail at its mean), with the fanbase,
+// reputation and market held where they are. Meant for comparing candidate
+// albums, not for predicting a career. Increases with quality.
+double ExpectedAlbumEarnings(double quality, const Player &player);
@@ -1,14 +1,16 @@
 #pragma once
 
+#include "genre.h"
 #include "song.h"
+#include "stringpool.h"
 
-#include <string>
+#include <string_view>
 #include <vector>
 
 struct Album {
-  std::string name;
-  std::string artist;
-  std::string genre;
+  StringId name;   // Interned (stringPool)
+  StringId artist; // Interned (stringPool)
+  Genre genre;
   std::vector<Song> tracks;
   double price;
   double quality;
@@ -21,7 +23,7 @@ struct Album {
   double earnings = 0.0;
   float lifeTime = 0.0f;
 
-  Album(std::string _name, std::string _artist, std::string _genre,
+  Album(std::string_view _name, std::string_view _artist, Genre _genre,
         std::vector<Song> _tracks, double _quality, int _currentFans,
         double _price);
 };
\ No newline at end of file
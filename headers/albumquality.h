@@ -0,0 +1,143 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// --- ALBUM QUALITY ---
+// How an album's quality follows from its track qualities.
+//   - AlbumQualityOfSorted (behind Player::CalcAlbumQuality) is the
+//     reference: the two-pass formula over a sorted tracklist.
+//   - AlbumQuality() below evaluates the same formula from an order-free
+//     summary, for AlbumQualityModel (a selection out of a fixed pool of
+//     candidates, the vault, updated one toggle at a time) and the
+//     tracklist search.
+// The summary sums in another order, so its base and spread may be off by
+// rounding (well under ALBUM_NEAR_CUTOFF relative). The cut-offs (cohesion
+// bonus, filler gate and threshold) would turn that into whole points, so
+// AlbumQualityModel::Estimate() falls back to the reference whenever a
+// value it decides on lies within ALBUM_NEAR_CUTOFF of one: its estimate
+// makes the same decisions as CalcAlbumQuality and differs from it by
+// rounding only.
+
+// Track weights by rank, best first: 0.85^rank with a 0.25 floor. The floor
+// is reached at rank ALBUM_HEAD, so only the head has individual weights.
+constexpr size_t ALBUM_HEAD = 9;
+constexpr double ALBUM_TAIL_WEIGHT = 0.25;
+
+constexpr std::array<double, ALBUM_HEAD> MakeAlbumWeights() {
+  std::array<double, ALBUM_HEAD> weights{};
+  double weight = 1.0;
+  for (double &w : weights) {
+    w = weight;
+    weight *= 0.85;
+  }
+  return weights;
+}
+constexpr std::array<double, ALBUM_HEAD> ALBUM_WEIGHTS = MakeAlbumWeights();
+
+static_assert(ALBUM_WEIGHTS[ALBUM_HEAD - 1] > ALBUM_TAIL_WEIGHT &&
+              ALBUM_WEIGHTS[ALBUM_HEAD - 1] * 0.85 < ALBUM_TAIL_WEIGHT);
+
+// Filler only counts on albums of at least this many tracks whose weighted
+// base beats ALBUM_FILLER_MIN_BASE; a filler track is below SHARE x base.
+constexpr size_t ALBUM_FILLER_MIN_TRACKS = 4;
+constexpr double ALBUM_FILLER_MIN_BASE = 40.0;
+constexpr double ALBUM_FILLER_SHARE = 0.6;
+
+// Cohesion bonus below this spread (standard deviation).
+constexpr double ALBUM_COHESION_MAX_STDEV = 5.0;
+
+// Relative distance from a cut-off inside which rounding may decide it.
+// The reference's own error grows with the track count (about n x 2^-53),
+// so this covers albums far past any vault's size.
+constexpr double ALBUM_NEAR_CUTOFF = 1e-9;
+
+// The reference formula; 'sortedSongs' is best first. 0 if empty.
+double AlbumQualityOfSorted(const std::vector<double> &sortedSongs);
+
+// Order-free summary of a tracklist, plus its best ALBUM_HEAD qualities.
+struct AlbumStats {
+  size_t count = 0;
+  double sum = 0.0;        // Sum of all qualities
+  double sumSquares = 0.0; // Sum of all squared qualities
+  double sumError = 0.0;   // Low parts of compensated sums (0 if plain)
+  double sumSquaresError = 0.0;
+  std::array<double, ALBUM_HEAD> head{}; // Best first; min(count, HEAD) used
+};
+
+// Weighted average (the "hit single" effect). count > 0.
+double AlbumBaseQuality(const AlbumStats &stats);
+
+// Sample standard deviation (0 below two tracks), free of the cancellation
+// in sumSquares - sum x mean.
+double AlbumStdev(const AlbumStats &stats);
+
+// Building blocks of AlbumFinalQuality, for searches that bound it.
+double AlbumCohesion(double stdev);      // Non-increasing in stdev
+double AlbumLengthBonus(size_t count);   // Non-decreasing in count
+double AlbumSoftCap(double rawQuality);  // Non-decreasing, clamps to [1, 100]
+
+// Cohesion, filler and length adjustments plus the soft cap, given the
+// base and the number of tracks below ALBUM_FILLER_SHARE x base.
+double AlbumFinalQuality(const AlbumStats &stats, double base,
+                         size_t fillerCount);
+
+// The whole formula. 'countBelow(threshold)' returns how many tracks have a
+// quality strictly below 'threshold'; it is only called when filler can
+// matter.
+template <typename CountBelow>
+double AlbumQuality(const AlbumStats &stats, CountBelow countBelow) {
+  if (stats.count == 0)
+    return 0.0;
+
+  double base = AlbumBaseQuality(stats);
+  size_t fillerCount = 0;
+  if (stats.count >= ALBUM_FILLER_MIN_TRACKS && base > ALBUM_FILLER_MIN_BASE)
+    fillerCount = countBelow(base * ALBUM_FILLER_SHARE);
+  return AlbumFinalQuality(stats, base, fillerCount);
+}
+
+// Album quality of a selection out of fixed candidates. Candidates are
+// ranked once (Reset, O(n log n)); the selection is a Fenwick tree of
+// counts over the ranks plus running sums, so Select() and Estimate() are
+// both O(log n) however many candidates there are.
+class AlbumQualityModel {
+public:
+  // New candidate pool (e.g. the vault's qualities); nothing selected.
+  void Reset(const std::vector<double> &qualities);
+
+  size_t Candidates() const { return quality.size(); }
+  bool IsSelected(size_t candidate) const { return selected[candidate]; }
+
+  // Adds or removes one candidate. No-op if already in that state.
+  void Select(size_t candidate, bool on);
+  void ClearSelection();
+
+  size_t Count() const { return count; } // Selected tracks
+
+  // Album quality of the current selection (0 if empty). O(log n) unless a
+  // cut-off is within rounding, then O(k log n) via the reference.
+  double Estimate() const;
+
+  // Summary of the current selection (what Estimate() evaluates).
+  AlbumStats Stats() const;
+
+private:
+  size_t SelectedBefore(size_t rank) const; // Selected among ranks < rank
+  size_t NthSelected(size_t n) const;       // Rank of the n-th (0-based)
+  size_t SelectedBelow(double threshold) const; // Quality < threshold
+  double Exact() const; // AlbumQualityOfSorted of the selection
+
+  std::vector<double> quality;   // By candidate
+  std::vector<uint32_t> rankOf;  // Candidate -> rank (0 = best)
+  std::vector<double> byRank;    // Qualities, best first
+  std::vector<uint8_t> selected; // By candidate
+  std::vector<uint32_t> tree;    // Fenwick tree over ranks (1-based)
+  size_t count = 0;
+  double sum = 0.0; // Compensated: plus sumError, and so on
+  double sumError = 0.0;
+  double sumSquares = 0.0;
+  double sumSquaresError = 0.0;
+};
@@ -0,0 +1,172 @@
+#pragma once
+
+#include "album.h"
+#include "genre.h"
+#include "performance.h"
+#include "song.h"
+#include "songstore.h"
+#include "stringpool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Cold per-release data. Only touched when a release is added and by the UI,
+// never by the economy tick.
+struct ReleaseInfo {
+  StringId name = 0;   // Interned (stringPool)
+  StringId artist = 0; // Interned (stringPool)
+  std::vector<SongId> tracks; // Ids in the catalog's trackStore; singles: {}
+  int fansAtRelease = 0;
+};
+
+// Structure-of-arrays store for released songs or albums.
+// Every hot field the economy tick reads or writes lives in its own
+// contiguous column, so a tick over N releases streams through a few dense
+// arrays instead of dragging names and track lists through the cache.
+// Index i in every column (and in 'info') refers to the same release.
+// Expiry removes by swap-and-pop, so indices are NOT in release order; sort
+// by 'id' (or lifeTime) where order matters.
+//
+// Releases [0, activeCount) are active; the rest are dormant: their hype
+// fell to DEAD_HYPE, which nothing ever raises again, so the tick skips them
+// for good and only ages them until they expire. Late-game catalogs are
+// mostly dormant, so the tick scales with the active range.
+//
+// Expiry is scheduled with a max-heap of indices keyed by lifeTime. Every
+// tick ages all releases by the same dt, which never changes their relative
+// order, so the heap stays valid without being touched and the release due
+// next is always on top. Next to it the catalog keeps every release in age
+// order (a queue: releases join at the young end and expire from the old
+// end), so the UI can walk releases newest first without sorting. Code that
+// fills columns or writes lifeTime or hype any other way must call
+// RebuildIndex() afterwards.
+//
+// The terms of the performance model that only depend on quality and price
+// (PerformanceCurve) are computed once, when a release is added, and kept in
+// columns of their own; the tick only reads them. Prices change through
+// Reprice(), which recomputes them.
+struct ReleaseCatalog {
+  // At or below this hype a release is dead (streams nothing)
+  static constexpr float DEAD_HYPE = 0.001f;
+
+  bool isAlbum = false;
+
+  // --- Hot columns (read/written every economy tick) ---
+  std::vector<uint32_t> id; // Stable per-catalog release id (RNG stream key)
+  std::vector<double> quality;
+  std::vector<double> hype; // 1.0 = Max, 0.0 = Dead
+  std::vector<double> price;
+  std::vector<float> lifeTime;
+  std::vector<Genre> genre;
+
+  // --- Release-time invariants (read every tick, see PerformanceCurve) ---
+  std::vector<double> decayTime;
+  std::vector<double> qualityPower;
+  std::vector<double> demand;
+  std::vector<double> salesChance;
+
+  // --- Stats columns ---
+  std::vector<int> dailyStreams;
+  std::vector<int> totalStreams;
+  std::vector<int> totalSales;
+  std::vector<double> earnings;
+
+  // --- Cold side table ---
+  std::vector<ReleaseInfo> info;
+  SongStore trackStore; // Album tracks, freed when their album expires
+
+  // Next id handed out by Add (never reused, survives expiry)
+  uint32_t nextId = 0;
+
+  // Releases [0, activeCount) are active, the rest dormant
+  size_t activeCount = 0;
+
+  // Curve math the invariant columns were computed with
+  CurveMode curves = GetCurveMode();
+
+  // Sum of the quality column, kept up to date by Add/RemoveExpired/Clear
+  // so reputation never has to re-scan the catalog
+  double qualitySum = 0.0;
+
+  explicit ReleaseCatalog(bool albums = false) : isAlbum(albums) {}
+
+  size_t Size() const { return quality.size(); }
+  bool Empty() const { return quality.empty(); }
+  size_t ActiveSize() const { return activeCount; }
+
+  // Index of the k-th youngest release (0 = newest, k < Size()). O(1).
+  size_t Newest(size_t k) const { return ageOrder[ageOrder.size() - 1 - k]; }
+
+  void Reserve(size_t count);
+
+  // Drops every release. Ids keep counting up so streams are never reused.
+  void Clear();
+
+  // Appends a release. An album's tracks move into trackStore.
+  void Add(const Song &song);
+  void Add(const Album &album);
+
+  // Removes every release whose lifeTime reached maxLifeTime. Only the
+  // releases actually due are touched: O(1) when nothing is due, O(log n)
+  // per removal. Returns the number removed.
+  size_t RemoveExpired(float maxLifeTime);
+
+  // Moves active release i to the dormant range (zeroing its daily
+  // streams). The last active release takes slot i.
+  void Demote(size_t i);
+
+  // Demotes every active release whose hype is at or below DEAD_HYPE.
+  // Returns the number demoted.
+  size_t DemoteDead();
+
+  // Sets release i's price and recomputes its invariants.
+  void Reprice(size_t i, double newPrice);
+
+  // Recomputes every release's invariants if they were computed with other
+  // curve math. O(1) when 'mode' is what they already use.
+  void SetCurveMode(CurveMode mode);
+
+  // Recomputes the invariants, re-partitions, re-sorts the expiry schedule
+  // and re-sums quality after columns were filled or changed directly
+  // (loading, benchmarks).
+  void RebuildIndex();
+
+  // Full re-sum of the quality column (what qualitySum tracks).
+  double SumQuality() const;
+
+private:
+  void PushHot(double q, double h, double p, float life, Genre g);
+
+  // Fills release i's invariant columns from its quality and price.
+  void ComputeInvariants(size_t i);
+
+  // Moves the release just added into the active range if it is live.
+  void PlaceNew();
+
+  // Exchanges two releases in every column (and in the schedule).
+  void SwapReleases(size_t a, size_t b);
+
+  // Moves the last release into slot i and shrinks every column by one.
+  void SwapAndPop(size_t i);
+
+  // Expiry heap helpers ('pos' = position in expiryHeap)
+  bool ExpiresBefore(uint32_t a, uint32_t b) const;
+  void SetHeap(size_t pos, uint32_t index);
+  void SiftUp(size_t pos);
+  void SiftDown(size_t pos);
+
+  // Age order helpers
+  void SetAge(size_t pos, uint32_t index);
+  void InsertByAge(uint32_t index);
+  void CompactAgeOrder();
+
+  std::vector<uint32_t> expiryHeap; // Release indices, next due on top
+  std::vector<uint32_t> heapSlot;   // Per release: its position in the heap
+
+  // Release indices oldest first; [0, ageHead) are expired leftovers that
+  // CompactAgeOrder() drops once they make up half the vector
+  std::vector<uint32_t> ageOrder;
+  std::vector<uint32_t> ageSlot; // Per release: its position in ageOrder
+  size_t ageHead = 0;
+};
@@ -1,7 +1,5 @@
 #pragma once
 
-#include <SFML/System/Time.hpp>
-
 struct EconomyConfig {
   static constexpr double STREAM_PAYOUT_RATE = 0.004;
   static constexpr double BASE_PRICE = 0.69;
@@ -11,8 +9,22 @@ struct EconomyConfig {
   static constexpr float REP_CYCLE = 5.0f;         // 5 seconds
   static constexpr float ECONOMY_TICK_RATE = 0.2f; // 5Hz
   static constexpr float PRICE_ELASTICITY = 2.5;
-  static constexpr sf::Time SONG_LIFETIME = sf::seconds(300.0f);  // 5 Minutes
-  static constexpr sf::Time ALBUM_LIFETIME = sf::seconds(500.0f); // 8 Minutes
+  // Lifetimes are plain seconds so the simulation core stays SFML-free
+  static constexpr float SONG_LIFETIME = 300.0f;  // 5 Minutes
+  static constexpr float ALBUM_LIFETIME = 500.0f; // 8 Minutes
+
+  // Quality response curves (see curves.h). Quality is kept in [1, 100].
+  static constexpr double MIN_QUALITY = 1.0;
+  static constexpr double MAX_QUALITY = 100.0;
+  // Organic discovery: (quality / 10)^2.5
+  static constexpr double DISCOVERY_QUALITY_SCALE = 10.0;
+  static constexpr double DISCOVERY_EXPONENT = 2.5;
+  // Fan conversion chance per stream: 0.2% plus up to 3.5% more along
+  // ((quality - 10) / 90)^2.5; nobody converts at or below quality 10
+  static constexpr double CONVERSION_BASE = 0.002;
+  static constexpr double CONVERSION_RANGE = 0.035;
+  static constexpr double CONVERSION_MIN_QUALITY = 10.0;
+  static constexpr double CONVERSION_EXPONENT = 2.5;
 };
 
 template <typename T>
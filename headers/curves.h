@@ -0,0 +1,116 @@
+#pragma once
+
+#include "config.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+// --- QUALITY RESPONSE CURVES ---
+// The smooth curves the economy evaluates for every release on every tick:
+// organic discovery (quality / 10)^2.5, the fan conversion chance and
+// freshness exp(-age). Besides the exact math (std::pow / std::exp), each
+// one has a table built at compile time (curves.cpp) from the constants in
+// EconomyConfig: value and slope at evenly spaced knots, cubic Hermite
+// interpolation in between. A lookup is a few multiply-adds with no call
+// into libm.
+//
+// Every table stays within CURVE_TABLE_TOLERANCE (relative) of the exact
+// curve; curves.cpp static_asserts this between every pair of knots, and
+// MusicTycoonSim --check-kernel measures it against libm. Streams and sales
+// are truncated to whole numbers, so a run on tables can differ from an
+// exact run by one stream or sale here and there (and everything random
+// that depends on it from then on).
+
+constexpr double CURVE_TABLE_TOLERANCE = 1e-6;
+
+// Which math the curve functions below use. SimulateEconomy and the scalar
+// kernel read the mode once per call / batch.
+enum class CurveMode { Exact, Table };
+
+CurveMode GetCurveMode(); // Default: Table
+void SetCurveMode(CurveMode mode);
+const char *CurveModeName(CurveMode mode);
+
+template <size_t Knots> struct CurveTable {
+  static_assert(Knots >= 2);
+
+  struct Knot {
+    double value = 0.0;
+    double slope = 0.0; // Derivative times the knot spacing
+  };
+
+  double lo = 0.0;
+  double hi = 0.0;
+  double invStep = 1.0; // Knots per unit of x
+  std::array<Knot, Knots> knots{};
+
+  bool Covers(double x) const { return x >= lo && x <= hi; }
+
+  // Interpolated value at x. Covers(x) must hold.
+  constexpr double operator()(double x) const {
+    double t = (x - lo) * invStep;
+    size_t i = std::min(static_cast<size_t>(t), Knots - 2);
+    double s = t - static_cast<double>(i);
+    const Knot &a = knots[i];
+    const Knot &b = knots[i + 1];
+
+    // y0 + m0 s + (3 dy - 2 m0 - m1) s^2 + (m0 + m1 - 2 dy) s^3
+    double dy = b.value - a.value;
+    double c2 = 3.0 * dy - 2.0 * a.slope - b.slope;
+    double c3 = a.slope + b.slope - 2.0 * dy;
+    return a.value + s * (a.slope + s * (c2 + s * c3));
+  }
+};
+
+// Knot spacing: 1/8 quality point, 1/16 of a decay time
+constexpr size_t QUALITY_KNOTS_PER_POINT = 8;
+constexpr size_t AGE_KNOTS_PER_UNIT = 16;
+constexpr double FRESHNESS_MAX_AGE = 8.0; // exp(-8) ~ 3e-4; exact beyond
+
+constexpr size_t DISCOVERY_KNOTS =
+    static_cast<size_t>(EconomyConfig::MAX_QUALITY -
+                        EconomyConfig::MIN_QUALITY) *
+        QUALITY_KNOTS_PER_POINT +
+    1;
+constexpr size_t CONVERSION_KNOTS =
+    static_cast<size_t>(EconomyConfig::MAX_QUALITY -
+                        EconomyConfig::CONVERSION_MIN_QUALITY) *
+        QUALITY_KNOTS_PER_POINT +
+    1;
+constexpr size_t FRESHNESS_KNOTS =
+    static_cast<size_t>(FRESHNESS_MAX_AGE) * AGE_KNOTS_PER_UNIT + 1;
+
+extern const CurveTable<DISCOVERY_KNOTS> DISCOVERY_TABLE;
+extern const CurveTable<CONVERSION_KNOTS> CONVERSION_TABLE;
+extern const CurveTable<FRESHNESS_KNOTS> FRESHNESS_TABLE;
+
+// (quality / 10)^2.5: organic discovery.
+inline double DiscoveryCurve(double quality, CurveMode mode) {
+  if (mode == CurveMode::Table && DISCOVERY_TABLE.Covers(quality))
+    return DISCOVERY_TABLE(quality);
+  return std::pow(quality / EconomyConfig::DISCOVERY_QUALITY_SCALE,
+                  EconomyConfig::DISCOVERY_EXPONENT);
+}
+
+// Chance that one stream converts a listener into a fan.
+inline double ConversionCurve(double quality, CurveMode mode) {
+  if (!(quality > EconomyConfig::CONVERSION_MIN_QUALITY))
+    return 0.0;
+  if (mode == CurveMode::Table && CONVERSION_TABLE.Covers(quality))
+    return CONVERSION_TABLE(quality);
+  return EconomyConfig::CONVERSION_BASE +
+         (std::pow((quality - EconomyConfig::CONVERSION_MIN_QUALITY) /
+                       (EconomyConfig::MAX_QUALITY -
+                        EconomyConfig::CONVERSION_MIN_QUALITY),
+                   EconomyConfig::CONVERSION_EXPONENT) *
+          EconomyConfig::CONVERSION_RANGE);
+}
+
+// exp(-age), age = lifeTime / decay time.
+inline double FreshnessCurve(double age, CurveMode mode) {
+  if (mode == CurveMode::Table && FRESHNESS_TABLE.Covers(age))
+    return FRESHNESS_TABLE(age);
+  return std::exp(-age);
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "genre.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+struct MarketState;
+
+// What happened. Each id has one fixed message text with typed arguments
+// (see LogArgs); the text is only formatted when a line is shown.
+enum class LogMessage : uint8_t {
+  EngineInitialized, // number = seed
+  Viral,             // number = new fans
+  Scandal,           // number = fans lost
+  MarketShift,       // genre, value = bonus
+  Recorded,          // text = song, genre, number = quality
+  NoEnergyToRecord,
+  ReleasedSingle, // text = song
+  ReleasedEP,     // text = album
+  ReleasedLP,     // text = album
+  NoEnergyToRelease,
+  Learned, // text = skill
+  Upgraded,
+  BuskTooShort,
+  Busked,         // value = minutes
+  NoEnergyToBusk, // value = minutes
+  VaultChanged,
+  GameSaved,
+  SaveFailed, // text = error
+  LoadedCareer,    // text = artist
+  LoadFailed,      // text = error
+  SkippedDays,     // number = days
+  RecordingFailed, // text = error
+};
+
+// Arguments of one message (unused ones stay at their defaults).
+struct LogArgs {
+  int64_t number = 0;
+  double value = 0.0;
+  Genre genre = Genre::Other;
+  std::string_view text = {}; // Copied (truncated to LogEntry::TEXT_SIZE - 1)
+};
+
+// One stored line: fixed size, so storing it never allocates.
+struct LogEntry {
+  static constexpr size_t TEXT_SIZE = 96;
+
+  LogMessage id = LogMessage::EngineInitialized;
+  Genre genre = Genre::Other;
+  int64_t number = 0;
+  double value = 0.0;
+  char text[TEXT_SIZE] = {};
+
+  // Writes the message text into 'buffer' (always NUL-terminated).
+  void Format(char *buffer, size_t size) const;
+};
+
+// Lives outside graphics.h so the headless simulation core can log without
+// pulling in SFML/ImGui. DrawWindow is implemented by the UI (graphics.cpp).
+//
+// A fixed ring of CAPACITY preallocated entries; the newest overwrites the
+// oldest. Add() is lock-free and safe from any number of threads at once
+// (the parallel tick logs from its workers): each call takes a ticket and
+// owns that slot while it copies. Reading (Get, copying, DrawWindow) must
+// not overlap with writers, e.g. the tick is done or the log is a snapshot.
+class EventLog {
+public:
+  static constexpr size_t CAPACITY = 64;
+
+  EventLog() = default;
+  EventLog(const EventLog &other) { *this = other; }
+  EventLog &operator=(const EventLog &other);
+
+  void Add(LogMessage id, const LogArgs &args = {});
+
+  // Lines currently held (at most CAPACITY).
+  size_t Size() const;
+  bool Empty() const { return Size() == 0; }
+
+  // Entry 'age' lines back (0 = newest). False if out of range or the slot
+  // was lost to a colliding writer.
+  bool Get(size_t age, LogEntry &entry) const;
+
+  // Formatted line (allocates; for tools and tests, not the tick).
+  std::string Text(size_t age) const;
+
+  void Clear();
+
+  void DrawWindow(float dt, const MarketState &market) const;
+
+private:
+  struct Slot {
+    // (ticket + 1) << 1 once written; low bit set while a writer copies
+    std::atomic<uint64_t> stamp{0};
+    LogEntry entry;
+  };
+
+  std::array<Slot, CAPACITY> slots;
+  std::atomic<uint64_t> head{0}; // Tickets handed out so far
+};
+
+extern EventLog gameLog; // Global instance
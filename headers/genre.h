@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// --- GENRE REGISTRY ---
+// The one list of genres. Songs, albums and the release catalogs store the
+// compact id; names are only looked up for display and logs.
+enum class Genre : uint8_t {
+  Pop,
+  Rock,
+  HipHop,
+  RnB,
+  Jazz,
+  Classical,
+  Other,
+  Electronic,
+  Country,
+  Folk,
+  Metal,
+  Indie,
+  Experimental,
+  Mixed, // Albums without a dominant genre. Not selectable, never trends.
+};
+
+// Genres a player can record (and the market can trend): everything before
+// Mixed.
+constexpr size_t GENRE_COUNT = static_cast<size_t>(Genre::Mixed);
+
+// Display names, indexed by id
+constexpr std::array<std::string_view, GENRE_COUNT + 1> GENRE_NAMES = {
+    "Pop",       "Rock",  "Hip-Hop",     "R&B",     "Jazz",
+    "Classical", "Other", "Electronic",  "Country", "Folk",
+    "Metal",     "Indie", "Experimental", "Mixed"};
+
+constexpr size_t GenreIndex(Genre genre) { return static_cast<size_t>(genre); }
+
+constexpr Genre GenreAt(size_t index) { return static_cast<Genre>(index); }
+
+constexpr std::string_view GenreName(Genre genre) {
+  return GENRE_NAMES[GenreIndex(genre)];
+}
+
+// Id for a display name (e.g. from a save or a config), 'fallback' if unknown.
+constexpr Genre GenreFromName(std::string_view name,
+                              Genre fallback = Genre::Other) {
+  for (size_t i = 0; i < GENRE_NAMES.size(); ++i) {
+    if (GENRE_NAMES[i] == name)
+      return GenreAt(i);
+  }
+  return fallback;
+}
+
+static_assert(GenreFromName("Hip-Hop") == Genre::HipHop);
+static_assert(GenreName(Genre::Experimental) == "Experimental");
@@ -1,39 +1,43 @@
 #pragma once
 
 #include "album.h"
+#include "catalog.h"
+#include "eventlog.h"
 #include "gamestate.h"
+#include "genre.h"
 #include "player.h"
+#include "simthread.h"
 #include "song.h"
+#include "world.h"
 
 #include <SFML/Graphics.hpp>
 #include <SFML/System/Time.hpp>
 
-#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
 
-struct EventLog {
-  std::deque<std::string> logs;
+Genre BeginDropDownMenu(bool IsOpen);
 
-  // Create the timer here so it "lives" as long as the EventLog does
-  std::shared_ptr<float> ticktimer = std::make_shared<float>(0.0f);
+// The in-game windows draw from the latest simulation snapshot and turn
+// button presses into commands for the simulation thread.
+void DrawStudioWindow(const WorldSnapshot &view, SimulationThread &sim);
 
-  void Add(const std::string &message);
-  void DrawWindow(sf::Time dt, std::shared_ptr<float> tickTimer);
-};
+void DrawActionsWindow(SimulationThread &sim);
 
-std::string BeginDropDownMenu(bool IsOpen);
+// The newest releases (WorldSnapshot::chart), with per-track tooltips.
+void DrawAnalyticsWindow(const WorldSnapshot &view);
 
-void DrawStudioWindow(Player &player, std::vector<Song> &songsMade,
-                      std::vector<Song> &songsReleased,
-                      std::vector<Album> &albumsReleased);
+// "Skills" shows player skills, any other title the studio tools.
+void DrawUpgradeWindow(const char *title, const WorldSnapshot &view,
+                       SimulationThread &sim);
 
-void DrawActionsWindow(Player &player);
+// Start a new career or continue the saved one. Runs before the simulation
+// thread starts, so it edits the world directly.
+void DrawMainMenu(GameState &state, World &world);
 
-void DrawAnalyticsWindow(const std::vector<Song> &songsReleased,
-                         const std::vector<Album> &albumsReleased);
+// Save / load buttons for the running career.
+void DrawSaveWindow(SimulationThread &sim);
 
-void DrawUpgradeWindow(const char *title, Player &player,
-                       std::vector<std::pair<std::string, double>> &items);
-
-void DrawMainMenu(GameState &state, Player &player);
-
-extern EventLog gameLog; // Global instance
\ No newline at end of file
+// Game speed (1x-1000x) and pause.
+void DrawSpeedWindow(const WorldSnapshot &view, SimulationThread &sim);
@@ -1,10 +1,38 @@
 #pragma once
 
+#include "genre.h"
+#include "rng.h"
+
+#include <cstdint>
 #include <string>
+#include <vector>
 
 // --- MODERN RANDOM ENGINE ---
+// Thin front end over RandomStream. Calls draw from the calling thread's
+// current stream: the session stream by default, or whatever a StreamScope
+// routed them to (e.g. one release's stream for one tick).
 namespace Random {
 
+constexpr uint64_t DEFAULT_SEED = 0x4D7573696354796Bull; // "MusicTyk"
+
+// Seed for the whole session. Resets the session stream.
+void Seed(uint64_t seed);
+uint64_t GetSeed();
+
+RandomStream &Current();
+
+// RAII: routes Random:: calls on this thread to 'stream' until destroyed.
+class StreamScope {
+public:
+  explicit StreamScope(RandomStream &stream);
+  ~StreamScope();
+  StreamScope(const StreamScope &) = delete;
+  StreamScope &operator=(const StreamScope &) = delete;
+
+private:
+  RandomStream *previous;
+};
+
 double Normal(double mean, double stdDev);
 
 // Returns integer between min and max (inclusive)
@@ -18,6 +46,10 @@ bool Chance(double probability01);
 
 std::string GenerateSongName();
 
-std::string GetAlbumGenre();
+// Most common genre among an album's tracks (first in registry order on
+// ties), Mixed if there are none.
+Genre GetAlbumGenre(const std::vector<Genre> &trackGenres);
+// Same, from per-genre track counts (indexed by GenreIndex).
+Genre GetAlbumGenre(const std::array<int, GENRE_COUNT> &genreCounts);
 
 double GetRecommendedPrice(double quality, bool IsAlbum);
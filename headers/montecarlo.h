@@ -0,0 +1,59 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// --- MONTE CARLO CAREER ENGINE ---
+// Runs many independent careers (one World each) across the shared thread
+// pool and summarizes where they end up. Career i is seeded from
+// (seed, i) alone, so a report is reproducible for any thread count.
+
+// What every simulated career does.
+struct CareerPlan {
+  long long ticks = 10000; // Economy ticks per career
+  int releaseEvery = 50;   // Release a new single every N ticks (0 = never)
+  double quality = 60.0;   // Fixed release quality (< 0 = roll via CalcQuality)
+  int startingSongs = 0;   // Singles already released at tick 0
+  int fans = 100;
+  double money = 50.0;
+};
+
+// Final state of one career.
+struct CareerOutcome {
+  double money = 0.0;
+  int fans = 0;
+  double reputation = 0.0;
+  long long releases = 0;
+};
+
+// Summary statistics of one outcome across all careers.
+struct Distribution {
+  static constexpr std::array<double, 7> PERCENTILES = {1,  5,  25, 50,
+                                                        75, 95, 99};
+
+  double mean = 0.0;
+  double stdDev = 0.0;
+  double min = 0.0;
+  double max = 0.0;
+  std::array<double, PERCENTILES.size()> percentiles{}; // Same order
+
+  // Equal-width bins over [min, max]
+  double binWidth = 0.0;
+  std::vector<size_t> histogram;
+};
+
+struct MonteCarloReport {
+  std::vector<CareerOutcome> outcomes; // Index = career
+  Distribution money;
+  Distribution fans;
+  Distribution reputation;
+  double wallSeconds = 0.0;
+};
+
+MonteCarloReport RunMonteCarlo(const CareerPlan &plan, size_t careers,
+                               uint64_t seed, size_t histogramBins = 20);
+
+// Mean, spread, percentiles (linear interpolation) and histogram of 'values'.
+Distribution Summarize(std::vector<double> values, size_t histogramBins);
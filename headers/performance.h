@@ -0,0 +1,68 @@
+#pragma once
+
+#include "curves.h"
+
+#include <cstddef>
+
+// --- BATCHED STREAM/SALES KERNEL ---
+// Evaluates the deterministic part of the per-release performance model for
+// a whole block of releases at once. The terms fixed at release
+// (PerformanceCurve: decay time, discovery power, demand, sales chance) are
+// computed once and stored with the release; per tick only freshness decay
+// and organic listeners are left. Random draws and integer rounding stay in
+// the caller, so the kernel is pure math over contiguous columns.
+
+// Instruction set used by EvaluatePerformance.
+enum class SimdLevel { Scalar, SSE2, AVX2 };
+
+// Best level supported by this CPU (checked once, at runtime).
+SimdLevel DetectSimdLevel();
+
+// Level used by SimulateEconomy. Defaults to DetectSimdLevel(); can be forced
+// down (e.g. to Scalar) to compare against the exact math. Requests above
+// what the CPU supports are clamped.
+SimdLevel GetSimdLevel();
+void SetSimdLevel(SimdLevel level);
+
+const char *SimdLevelName(SimdLevel level);
+
+// The SIMD paths replace std::exp with a polynomial approximation. Their
+// raw outputs stay within this relative error of the Scalar path (after
+// truncation to int, streams may therefore differ by at most 1).
+constexpr double PERFORMANCE_KERNEL_TOLERANCE = 1e-12;
+
+// Column pointers for one block of releases. The kernel only covers the
+// player-independent terms; the caller adds fan listeners and the reputation
+// boost, which change as UpdateFanbase runs between releases.
+struct PerformanceBatch {
+  size_t count = 0;
+  CurveMode curves = CurveMode::Exact; // Scalar path only (see curves.h)
+
+  // Inputs
+  const double *hype = nullptr;
+  const float *lifeTime = nullptr;
+  const double *decayTime = nullptr;    // PerformanceCurve::decayTime
+  const double *qualityPower = nullptr; // PerformanceCurve::qualityPower
+  const double *trendBonus = nullptr; // 1.0, or 1 + multiplier if trending
+  const double *viralBase = nullptr;  // Normal(50 or 150, 15) draw
+
+  // Outputs
+  double *organic = nullptr; // Organic (non-fan) listeners
+};
+
+void EvaluatePerformance(const PerformanceBatch &batch, SimdLevel level);
+
+// Per-release terms of the model that do not change from tick to tick
+// (Scalar math). ReleaseCatalog stores them when a release is added; the
+// analytic fast-forward builds its closed forms on them.
+// With CurveMode::Table, discovery comes from its table and demand from
+// r^-3 = 1 / r^3 and r^-2.5 = 1 / (r^2 sqrt(r)) instead of std::pow.
+struct PerformanceCurve {
+  double decayTime = 1.0;    // Freshness = exp(-lifeTime / decayTime)
+  double qualityPower = 0.0; // Organic = viral * this * trend * fresh * hype
+  double demand = 1.0;       // Price elasticity multiplier
+  double salesChance = 0.0;  // Per-stream purchase probability
+};
+
+PerformanceCurve EvaluatePerformanceCurve(double quality, double price,
+                                          bool isAlbum, CurveMode curves);
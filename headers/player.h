@@ -1,10 +1,47 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
+struct EventLog;
+
+// --- SKILLS & STUDIO TOOLS ---
+// Fixed sets, so levels live in enum-indexed arrays (no names per player).
+
+enum class Skill : uint8_t {
+  Voice,
+  Producing,
+  Writing,
+  Recording,
+  Mixing,
+  Mastering,
+};
+
+enum class Tool : uint8_t {
+  Mic,
+  LiveMixer,
+  Soundboard,
+  Acoustics,
+  AudioEditor,
+  Computer,
+};
+
+constexpr size_t SKILL_COUNT = 6;
+constexpr size_t TOOL_COUNT = 6;
+
+// Display names, indexed by id (also the keys in save files)
+constexpr std::array<std::string_view, SKILL_COUNT> SKILL_NAMES = {
+    "Voice", "Producing", "Writing", "Recording", "Mixing", "Mastering"};
+constexpr std::array<std::string_view, TOOL_COUNT> TOOL_NAMES = {
+    "Mic",       "Live Mixer",   "Soundboard",
+    "Acoustics", "Audio Editor", "Computer"};
+
 struct Player {
   std::string name;
   int fans = 100;
@@ -14,28 +51,49 @@ struct Player {
 
   float repUpdateAccumulator = 0.0f;
 
-  // Skill Name, Level
-  std::vector<std::pair<std::string, double>> skills = {
-      {"Voice", 1.0},     {"Producing", 0.3}, {"Writing", 0.9},
-      {"Recording", 0.5}, {"Mixing", 0.3},    {"Mastering", 0.3}};
-
-  // Tool Name, Level (Refactored to double for math consistency)
-  std::vector<std::pair<std::string, double>> studio_tools = {
-      {"Mic", 1.0},       {"Live Mixer", 0.3},   {"Soundboard", 0.9},
-      {"Acoustics", 0.5}, {"Audio Editor", 0.3}, {"Computer", 0.3}};
-
   Player(std::string n) : name(std::move(n)) {}
 
+  // --- Levels ---
+  // Read freely; write only through the setters, which mark the cached
+  // base quality stale.
+  const std::array<double, SKILL_COUNT> &Skills() const { return skills; }
+  const std::array<double, TOOL_COUNT> &Tools() const { return tools; }
+  double SkillLevel(Skill skill) const {
+    return skills[static_cast<size_t>(skill)];
+  }
+  double ToolLevel(Tool tool) const {
+    return tools[static_cast<size_t>(tool)];
+  }
+  void SetSkillLevel(Skill skill, double level);
+  void SetToolLevel(Tool tool, double level);
+
   // 1. STABLE UI CALCULATION
+  // Cached: recomputed only after a level changed.
   double GetBaseQuality() const;
 
+  // The three best skills, best first (ties: lower id first). Cached with
+  // the base quality.
+  const std::array<Skill, 3> &TopSkills() const;
+
   // 2. RANDOMIZED RECORDING CALCULATION
   double CalcQuality() const;
 
   // 3. ALBUM AGGREGATION
-  double CalcAlbumQuality(const std::vector<double> &songQualities);
+  double CalcAlbumQuality(const std::vector<double> &songQualities) const;
 
-  double Busk(double TimeBusking);
+  // Outcome messages go to 'log' (nullptr = dropped).
+  double Busk(double TimeBusking, EventLog *log);
 
   double Rest();
+
+private:
+  // Recomputes the base quality and top skills if a level changed.
+  void Refresh() const;
+
+  std::array<double, SKILL_COUNT> skills = {1.0, 0.3, 0.9, 0.5, 0.3, 0.3};
+  std::array<double, TOOL_COUNT> tools = {1.0, 0.3, 0.9, 0.5, 0.3, 0.3};
+
+  mutable bool levelsDirty = true;
+  mutable double baseQuality = 5.0;
+  mutable std::array<Skill, 3> topSkills = {};
 };
\ No newline at end of file
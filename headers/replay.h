@@ -0,0 +1,200 @@
+#pragma once
+
+#include "curves.h"
+#include "performance.h"
+#include "simthread.h"
+#include "world.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// --- INPUT RECORDING AND REPLAY ---
+// A recording is everything needed to run a play session again without the
+// UI: the world as it was when recording started, then every player action
+// with the step it was applied at (StepWorld calls since recording started;
+// the economy tick only advances while something is released, so it cannot
+// place an action). The economy itself is not recorded; it is deterministic
+// given the world, the actions, the SIMD level and the curve mode (both
+// stored in the header).
+//
+// Layout (little-endian, every record 8-byte aligned):
+//   ReplayHeader | ReplayRecord + payload | ReplayRecord + payload | ...
+//
+// Records are appended (and flushed) as the session goes, so a recording
+// cut short by a crash replays up to its last whole record. A clean close
+// appends an End record carrying a checksum of the final world, which the
+// replayer compares against its own.
+//
+// Vault songs are stored by insertion sequence number (SlotMap::Sequence),
+// not by SlotHandle: handles are only meaningful in the vault that issued
+// them. Numbers are relative to the last Snapshot, counted as if the vault
+// had just been loaded from it: the snapshot's songs are 0..n-1 in save
+// order (oldest first) and the songs recorded after it n, n+1, ... So the
+// replayer, which does load it, finds a song at its vault's first number
+// after the load plus the stored one.
+namespace ReplayFormat {
+
+constexpr char MAGIC[8] = {'M', 'T', 'Y', 'C', 'R', 'P', 'L', 'Y'};
+constexpr uint32_t VERSION = 2; // 2: vault sequence numbers (were ranks)
+constexpr uint32_t ENDIAN_TAG = 0x01020304;
+constexpr uint64_t NO_SONG = UINT64_MAX; // Handle not in the vault
+
+enum class RecordKind : uint32_t {
+  Snapshot = 1, // payload = save file (savegame.h) of the whole world
+  Action,       // payload = track numbers (uint64 each), then text
+  End,          // checksum = WorldChecksum of the final world
+};
+
+struct ReplayHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t endianTag;
+  uint64_t seed;     // World::seed when recording started
+  uint8_t simdLevel; // SimdLevel
+  uint8_t curveMode; // CurveMode
+  uint8_t pad[6];
+};
+
+struct ReplayRecord {
+  uint64_t step;        // StepWorld calls since recording started
+  uint64_t tick;        // world.economy.tick then (checked on replay)
+  uint32_t kind;        // RecordKind
+  uint32_t command;     // SimCommandKind (Action)
+  uint64_t payloadSize; // Bytes, before padding to 8
+  uint64_t index;
+  double cost;
+  double gain;
+  double amount;
+  uint64_t checksum; // End
+  uint64_t song;     // Vault number or NO_SONG
+  uint32_t trackCount;
+  uint32_t textLength;
+  uint8_t genre;
+  uint8_t skill;
+  uint8_t pad[6];
+};
+
+static_assert(sizeof(ReplayHeader) == 32);
+static_assert(sizeof(ReplayRecord) == 96);
+static_assert(std::is_trivially_copyable_v<ReplayRecord>);
+
+} // namespace ReplayFormat
+
+// --- RECORDING FILES ---
+// The app writes each session to its own file, session-YYYYMMDD-HHMMSS.mtr
+// (local time), and keeps only the newest few.
+
+// <user data>/MusicTycoon/recordings: %APPDATA% on Windows, $XDG_DATA_HOME
+// (else ~/.local/share) elsewhere; ./recordings if none of these is set.
+std::string RecordingDirectory();
+
+// Creates 'dir' if needed, deletes its oldest session recordings so that at
+// most 'keep' - 1 remain, and sets 'path' to a fresh name for the next one.
+bool NextRecordingPath(const std::string &dir, size_t keep, std::string &path,
+                       std::string &error);
+
+// Hash of the simulated state of 'world': player, economy and market, clock,
+// session stream position, vault and both catalogs. Names and the log are
+// left out. Two worlds that will play out the same have the same checksum.
+uint64_t WorldChecksum(const World &world);
+
+// Folds one tick's state into a running checksum.
+uint64_t RollChecksum(uint64_t rolling, uint64_t state);
+
+class InputRecorder {
+public:
+  InputRecorder() = default;
+  ~InputRecorder();
+
+  InputRecorder(const InputRecorder &) = delete;
+  InputRecorder &operator=(const InputRecorder &) = delete;
+
+  // Creates (truncates) 'path' and records 'world' as the starting point.
+  // Uses the current SimdLevel and CurveMode.
+  bool Open(const std::string &path, const World &world, std::string &error);
+
+  // Appends the End record and closes the file. Returns false if any write
+  // failed.
+  bool Close(const World &world);
+
+  bool IsOpen() const { return file != nullptr; }
+  uint64_t Actions() const { return actions; }
+
+  // Counts one StepWorld call on the recorded world.
+  void Stepped() { ++steps; }
+
+  // Notes 'command' just before it is applied to 'world'. Save and Load are
+  // not actions (a Load is followed by Snapshot()).
+  void Note(const World &world, const SimCommand &command);
+
+  // Records the whole world again (after a Load replaced it).
+  void Snapshot(const World &world);
+
+private:
+  // Writes 'record' followed by 'payload' and flushes.
+  void Append(const ReplayFormat::ReplayRecord &record);
+
+  // Number of 'song' relative to the last Snapshot (see ReplayFormat).
+  uint64_t SongNumber(const World &world, SlotHandle song) const;
+
+  std::FILE *file = nullptr;
+  bool ok = true;
+  uint64_t steps = 0;
+  uint64_t actions = 0;
+  uint64_t snapshotNext = 0;           // Vault NextSequence() at Snapshot
+  std::vector<uint64_t> snapshotSongs; // Vault sequence numbers then, sorted
+  std::vector<unsigned char> payload;  // Of the record being appended
+};
+
+// One recorded event, with the embedded save decoded.
+struct ReplayEvent {
+  uint64_t step = 0;
+  uint64_t tick = 0;
+  ReplayFormat::RecordKind kind = ReplayFormat::RecordKind::Action;
+  SimCommand command; // Handles left empty; see song / tracks
+  uint64_t song = ReplayFormat::NO_SONG; // Vault numbers (see ReplayFormat)
+  std::vector<uint64_t> tracks;
+  std::vector<unsigned char> save; // Snapshot
+};
+
+struct Recording {
+  uint64_t seed = 0;
+  SimdLevel simd = SimdLevel::Scalar;
+  CurveMode curves = CurveMode::Exact;
+  std::vector<ReplayEvent> events; // Starts with a Snapshot
+
+  bool complete = false; // Has an End record (else: cut short)
+  uint64_t endStep = 0;
+  uint64_t endTick = 0;
+  uint64_t checksum = 0; // WorldChecksum at the end
+};
+
+// Reads a whole recording. A truncated tail is dropped (complete = false).
+bool LoadRecording(const std::string &path, Recording &recording,
+                   std::string &error);
+
+struct ReplayResult {
+  uint64_t steps = 0; // StepWorld calls
+  uint64_t ticks = 0; // Economy ticks simulated (fast-forwards included)
+  uint64_t actions = 0;
+  uint64_t checksum = 0; // WorldChecksum of the final world
+  uint64_t rolling = 0;  // RollChecksum over every step (if onTick was set)
+  bool verified = false; // The recording had an End record to compare with
+  bool matches = false;  // ... and 'checksum' equals it
+};
+
+// Runs 'recording' on 'world' as fast as the CPU allows: loads each
+// snapshot, steps one ECONOMY_TICK_RATE at a time up to the next action and
+// applies it, and stops at the End step (or after the last action). Fails
+// as soon as the economy tick differs from the recorded one. The caller sets
+// the SIMD level and curve mode. 'onStep' (optional) gets the step number
+// and rolling checksum after every step; hashing the world each step costs
+// about as much as the tick itself.
+bool ReplaySession(const Recording &recording, World &world,
+                   const std::function<void(uint64_t, uint64_t)> &onStep,
+                   ReplayResult &result, std::string &error);
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+// --- COUNTER-BASED RANDOM NUMBERS (Philox4x32-10) ---
+// Every draw is a pure function of (seed, stream, id, tick, draw index), so
+// there is no shared generator state. Each release on each tick gets its own
+// independent stream: results do not depend on iteration order or on which
+// thread runs the release, and one seed reproduces a whole career.
+
+namespace Philox {
+
+using Counter = std::array<uint32_t, 4>;
+using Key = std::array<uint32_t, 2>;
+
+inline Counter Block(Counter ctr, Key key) {
+  constexpr uint32_t M0 = 0xD2511F53u;
+  constexpr uint32_t M1 = 0xCD9E8D57u;
+  constexpr uint32_t W0 = 0x9E3779B9u;
+  constexpr uint32_t W1 = 0xBB67AE85u;
+
+  for (int round = 0; round < 10; ++round) {
+    uint64_t p0 = static_cast<uint64_t>(M0) * ctr[0];
+    uint64_t p1 = static_cast<uint64_t>(M1) * ctr[2];
+    uint32_t hi0 = static_cast<uint32_t>(p0 >> 32);
+    uint32_t lo0 = static_cast<uint32_t>(p0);
+    uint32_t hi1 = static_cast<uint32_t>(p1 >> 32);
+    uint32_t lo1 = static_cast<uint32_t>(p1);
+
+    ctr = {hi1 ^ ctr[1] ^ key[0], lo1, hi0 ^ ctr[3] ^ key[1], lo0};
+    key[0] += W0;
+    key[1] += W1;
+  }
+  return ctr;
+}
+
+} // namespace Philox
+
+// What a stream is used for. Part of the counter, so streams for different
+// purposes never overlap even with the same id and tick.
+enum class RngStream : uint32_t {
+  Session = 0, // Player actions (recording, busking, names)
+  Market,      // Trend shifts (id = shift number)
+  Churn,       // End-of-tick churn and scandals
+  SongViral,   // Per-single discovery draw
+  SongTick,    // Per-single long tail and fanbase rolls
+  AlbumViral,
+  AlbumTick,
+  Career,      // Per-career seeds for Monte Carlo runs (id = career index)
+  FastForward, // Aggregate draws of an analytic span (id = release, tick =
+               // first tick of the span)
+};
+
+class RandomStream {
+public:
+  RandomStream() = default;
+
+  // 'id' and 'tick' may use up to 44 bits each.
+  RandomStream(uint64_t seed, RngStream stream, uint64_t id = 0,
+               uint64_t tick = 0);
+
+  uint64_t NextU64();
+
+  // Uniform in [0, 1) with 53 random bits.
+  double NextDouble();
+
+  double Normal(double mean, double stdDev);
+
+  // Returns integer between min and max (inclusive)
+  int Int(int min, int max);
+  double Double(double min, double max);
+  bool Chance(double probability01);
+
+  // Position in the stream (64-bit draws so far), for save/restore. A stream
+  // rebuilt with the same constructor arguments and Seek(Tell()) continues
+  // exactly where this one is.
+  uint64_t Tell() const;
+  void Seek(uint64_t draws);
+
+private:
+  Philox::Key key = {0, 0};
+  Philox::Counter counter = {0, 0, 0, 0}; // counter[0] = block index
+  uint64_t spare = 0;
+  bool hasSpare = false;
+};
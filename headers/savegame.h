@@ -0,0 +1,154 @@
+#pragma once
+
+#include "world.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <type_traits>
+
+// --- SAVE FILES ---
+// Versioned binary snapshot of a whole World (player, vault, both release
+// catalogs, market/economy state, clock and RNG position).
+//
+// Layout (little-endian, every section 8-byte aligned):
+//   SaveHeader | SaveSection[sectionCount] | record arrays... | string table
+//
+// Every section is an array of fixed-size records, so a load maps the file,
+// checks the header and walks the arrays in place; there is nothing to
+// parse. Strings live in one table at the end and records refer to them by
+// (offset, length). Readers use the recordSize stored per section as the
+// stride, so a later version can append fields to a record without
+// breaking older saves.
+namespace SaveFormat {
+
+constexpr char MAGIC[8] = {'M', 'T', 'Y', 'C', 'S', 'A', 'V', 'E'};
+constexpr uint32_t VERSION = 1;
+constexpr uint32_t ENDIAN_TAG = 0x01020304; // Reads back swapped on BE hosts
+
+enum class SectionKind : uint32_t {
+  World = 1,   // 1 WorldRecord
+  Skills,      // LevelRecord per player skill
+  Tools,       // LevelRecord per studio tool
+  Vault,       // SongRecord per unreleased song
+  Songs,       // ReleaseRecord per released single
+  Albums,      // ReleaseRecord per released album
+  AlbumTracks, // SongRecord per album track (see ReleaseRecord::firstTrack)
+  Strings,     // char per byte of string data
+};
+constexpr uint32_t SECTION_COUNT = 8;
+
+struct StringRef {
+  uint32_t offset = 0; // Into the Strings section
+  uint32_t length = 0;
+};
+
+struct SaveHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t endianTag;
+  uint32_t sectionCount;
+  uint32_t reserved;
+  uint64_t fileSize;
+};
+
+struct SaveSection {
+  uint32_t kind; // SectionKind
+  uint32_t recordSize;
+  uint64_t offset; // From the start of the file
+  uint64_t count;
+};
+
+struct WorldRecord {
+  uint64_t seed;
+  uint64_t rngPosition; // RandomStream::Tell() of the session stream
+  uint64_t economySeed;
+  uint64_t economyTick;
+  uint64_t marketShiftCount;
+  double money;
+  double reputation;
+  double energy;
+  StringRef playerName;
+  int32_t fans;
+  float repUpdateAccumulator;
+  float clock;
+  float economyAccumulator;
+  float marketMultiplier;
+  uint32_t songsNextId;
+  uint32_t albumsNextId;
+  uint8_t marketInitialized;
+  uint8_t marketGenre;
+  uint8_t tickMode;
+  uint8_t pad[1];
+};
+
+struct LevelRecord {
+  StringRef name;
+  double level;
+};
+
+struct SongRecord {
+  StringRef name;
+  StringRef artist;
+  double price;
+  double quality;
+  double hype;
+  double earnings;
+  int32_t fansAtRelease;
+  int32_t dailyStreams;
+  int32_t totalStreams;
+  int32_t totalSales;
+  float lifeTime;
+  uint8_t genre;
+  uint8_t pad[3];
+};
+
+struct ReleaseRecord {
+  StringRef name;
+  StringRef artist;
+  double quality;
+  double hype;
+  double price;
+  double earnings;
+  uint32_t id;
+  int32_t dailyStreams;
+  int32_t totalStreams;
+  int32_t totalSales;
+  int32_t fansAtRelease;
+  float lifeTime;
+  uint32_t firstTrack; // Albums: index into AlbumTracks
+  uint32_t trackCount;
+  uint8_t genre;
+  uint8_t pad[7];
+};
+
+// Records are written and read as raw bytes; keep them padding-free and
+// their sizes fixed.
+static_assert(sizeof(SaveHeader) == 32);
+static_assert(sizeof(SaveSection) == 24);
+static_assert(sizeof(WorldRecord) == 104);
+static_assert(sizeof(LevelRecord) == 16);
+static_assert(sizeof(SongRecord) == 72);
+static_assert(sizeof(ReleaseRecord) == 88);
+static_assert(std::is_trivially_copyable_v<ReleaseRecord>);
+
+} // namespace SaveFormat
+
+// Streams 'world' to 'path' (via a temporary file, so an existing save is
+// only replaced once the new one is complete). The log and telemetry
+// pointers are not saved.
+bool SaveWorld(const World &world, const std::string &path,
+               std::string &error);
+
+// Replaces 'world' with the save at 'path'. The world keeps its clock
+// pointer (the value is restored), its log and its telemetry recorder. On
+// failure 'world' is left untouched.
+bool LoadWorld(World &world, const std::string &path, std::string &error);
+
+// The same, for a save embedded in another file: SaveWorld writes one at the
+// file's current position (offsets count from there) and leaves the file at
+// its end; LoadWorld reads one from memory.
+bool SaveWorld(const World &world, std::FILE *file, std::string &error);
+bool LoadWorld(World &world, const unsigned char *data, uint64_t size,
+               std::string &error);
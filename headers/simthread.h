@@ -0,0 +1,197 @@
+#pragma once
+
+#include "Simulation.h"
+#include "catalog.h"
+#include "eventlog.h"
+#include "genre.h"
+#include "player.h"
+#include "slotmap.h"
+#include "song.h"
+#include "world.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class InputRecorder;
+
+// --- SIMULATION THREAD ---
+// Runs a World on its own thread with a fixed timestep: every step is
+// exactly one economy tick (ECONOMY_TICK_RATE seconds of game time), and
+// game time advances at 'speed' x wall time. A slow frame on the UI thread
+// no longer costs ticks, and the UI no longer pays for them.
+//
+// While the thread runs it owns the World. The UI reads immutable snapshots
+// and changes the world only by posting commands, which the thread applies
+// between ticks in the order they were posted.
+
+// One release on the charts, copied out of its catalog.
+struct ChartRow {
+  StringId name = 0;
+  bool album = false;
+  double hype = 0.0;
+  int dailyStreams = 0;
+  int totalStreams = 0;
+  int totalSales = 0;
+  double earnings = 0.0;
+  uint32_t firstTrack = 0; // Albums: into WorldSnapshot::chartTracks
+  uint32_t trackCount = 0;
+};
+
+// One album track, with its share of the album's totals.
+struct ChartTrack {
+  StringId name = 0;
+  double quality = 0.0;
+  double streams = 0.0;
+  double earnings = 0.0;
+};
+
+// Everything the UI draws, copied out of the World after a batch of ticks.
+// Only what the windows show: the catalogs contribute their CHART_ROWS
+// newest releases and their sizes, so a publish costs the same however
+// large they grow. The vault is only re-copied when it changed.
+struct WorldSnapshot {
+  static constexpr size_t CHART_ROWS = 200;
+
+  uint64_t tick = 0;          // Economy ticks so far
+  double gameSeconds = 0.0;   // Game time simulated by this thread
+  float speed = 1.0f;
+  bool paused = false;
+  bool lagging = false; // The thread could not keep up with 'speed'
+
+  Player player{""};
+  SlotMap<Song> vault; // Handles match the world's vault
+
+  std::vector<ChartRow> chart; // Newest first, singles and albums merged
+  std::vector<ChartTrack> chartTracks;
+  size_t songCount = 0;  // Live singles
+  size_t albumCount = 0; // Live albums
+
+  MarketState market;
+  EventLog log; // Copy of the world's log
+};
+
+// Lock-free single-producer / single-consumer snapshot hand-off. The
+// simulation fills the back buffer and swaps it with the hand-off slot; the
+// UI swaps the hand-off slot with its front buffer when a newer one is
+// there. Neither side ever waits, and the front buffer stays untouched until
+// the UI acquires again.
+class SnapshotBuffer {
+public:
+  // --- Simulation thread ---
+  WorldSnapshot &Back() { return slots[back]; }
+  void Publish();
+
+  // --- UI thread ---
+  // Latest published snapshot. Valid until the next Acquire().
+  const WorldSnapshot &Acquire();
+
+private:
+  static constexpr uint32_t INDEX_MASK = 3;
+  static constexpr uint32_t FRESH = 4; // Hand-off slot not yet acquired
+
+  WorldSnapshot slots[3];
+  uint32_t back = 0;                  // Simulation side
+  uint32_t front = 1;                 // UI side
+  std::atomic<uint32_t> handoff{2};   // Slot index | FRESH
+};
+
+enum class SimCommandKind {
+  RecordSong,    // text = name, genre
+  ReleaseSingle, // song
+  ReleaseAlbum,  // text = name, tracks
+  Upgrade,       // skill, index, cost, gain
+  Busk,          // amount = minutes
+  Rest,
+  Save,        // text = path
+  Load,        // text = path
+  FastForward, // index = economy ticks (days) to skip
+};
+
+// One UI action. Vault songs are named by handle: if one was released (or a
+// save loaded) since the UI drew its snapshot, the release is skipped.
+struct SimCommand {
+  SimCommandKind kind = SimCommandKind::Rest;
+  std::string text;
+  Genre genre = Genre::Pop;
+  size_t index = 0;
+  SlotHandle song;
+  std::vector<SlotHandle> tracks; // Album track order
+  bool skill = false; // Upgrade: skills (true) or studio tools (false)
+  double cost = 0.0;
+  double gain = 0.0;
+  double amount = 0.0;
+};
+
+// Applies one player action (anything but Save and Load) to 'world', as the
+// simulation thread does between ticks. Draws come from whatever stream is
+// installed (the thread and the replayer install world.rng).
+void ApplyAction(World &world, const SimCommand &command);
+
+class SimulationThread {
+public:
+  static constexpr float MIN_SPEED = 1.0f;
+  static constexpr float MAX_SPEED = 1000.0f;
+
+  // Game seconds the thread may fall behind before it stops catching up
+  // (the run then slows down instead of skipping ticks).
+  static constexpr double MAX_BACKLOG = 2.0;
+
+  // Longest gap between snapshots while the world is changing (~60 Hz).
+  static constexpr double PUBLISH_INTERVAL = 1.0 / 60.0;
+
+  explicit SimulationThread(World &world);
+  ~SimulationThread();
+
+  SimulationThread(const SimulationThread &) = delete;
+  SimulationThread &operator=(const SimulationThread &) = delete;
+
+  // Publishes a first snapshot and starts stepping. Until Stop(), only the
+  // simulation thread may touch the world.
+  void Start();
+
+  // Applies pending commands, stops the thread and hands the world back.
+  void Stop();
+
+  // Every command applied from now on is also noted in 'recorder' (nullptr
+  // = none). Only while the thread is stopped.
+  void Record(InputRecorder *recorder) { this->recorder = recorder; }
+
+  bool Running() const { return thread.joinable(); }
+
+  // --- UI thread ---
+  const WorldSnapshot &Acquire() { return snapshots.Acquire(); }
+  void Post(SimCommand command);
+  void SetSpeed(float speed);
+  void SetPaused(bool paused);
+
+private:
+  void Run();
+  void Apply(const SimCommand &command);
+  void Fill(WorldSnapshot &snapshot);
+
+  World &world;
+  SnapshotBuffer snapshots;
+  InputRecorder *recorder = nullptr;
+
+  std::atomic<float> speed{1.0f};
+  std::atomic<bool> paused{false};
+
+  // Simulation thread
+  double gameSeconds = 0.0;
+  bool lagging = false;
+  std::vector<double> trackStreams, trackEarnings; // Fill() scratch
+
+  // Command queue (guarded by 'mutex')
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::vector<SimCommand> commands;
+  bool stopping = false;
+
+  std::thread thread;
+};
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Stable reference to a SlotMap element. Valid until that element is
+// erased; after that it never resolves again, not even to an element that
+// reuses its slot (the generation differs).
+struct SlotHandle {
+  uint32_t index = UINT32_MAX; // Slot
+  uint32_t generation = 0;
+
+  bool operator==(const SlotHandle &) const = default;
+};
+
+// --- GENERATIONAL SLOT MAP ---
+// Values live densely packed (iterate them like a vector); handles go
+// through a slot table, so Insert, Erase and lookup are all O(1) and no
+// handle is invalidated by erasing a different element.
+//
+// Erase moves the last value into the hole, so dense positions are NOT in
+// insertion order. Each value keeps its insertion sequence number for
+// callers that need that order (InsertionOrder()) or a name for an element
+// that outlives its handle (Sequence() / Find(), both O(1)).
+template <typename T> class SlotMap {
+public:
+  size_t Size() const { return values.size(); }
+  bool Empty() const { return values.empty(); }
+
+  // Changes on every Insert, Erase and Clear (and survives copies), so a
+  // cache of anything derived from the elements or their dense positions
+  // can tell whether it is still current.
+  uint64_t Revision() const { return revision; }
+
+  void Reserve(size_t count) {
+    values.reserve(count);
+    owners.reserve(count);
+    sequence.reserve(count);
+    bySequence.reserve(count);
+  }
+
+  void Clear() {
+    // Bump every live slot so no old handle resolves again
+    for (uint32_t slot : owners) {
+      ++slots[slot].generation;
+      freeSlots.push_back(slot);
+    }
+    values.clear();
+    owners.clear();
+    sequence.clear();
+    bySequence.clear();
+    ++revision;
+  }
+
+  SlotHandle Insert(T value) {
+    uint32_t slot;
+    if (!freeSlots.empty()) {
+      slot = freeSlots.back();
+      freeSlots.pop_back();
+    } else {
+      slot = static_cast<uint32_t>(slots.size());
+      slots.push_back({});
+    }
+    slots[slot].dense = static_cast<uint32_t>(values.size());
+    values.push_back(std::move(value));
+    owners.push_back(slot);
+    bySequence.emplace(nextSequence, slot);
+    sequence.push_back(nextSequence++);
+    ++revision;
+    return {slot, slots[slot].generation};
+  }
+
+  // Removes the element 'handle' refers to. False if it was already gone.
+  bool Erase(SlotHandle handle) {
+    if (!Contains(handle))
+      return false;
+
+    uint32_t dense = slots[handle.index].dense;
+    uint32_t last = static_cast<uint32_t>(values.size() - 1);
+    bySequence.erase(sequence[dense]);
+    if (dense != last) {
+      values[dense] = std::move(values[last]);
+      owners[dense] = owners[last];
+      sequence[dense] = sequence[last];
+      slots[owners[dense]].dense = dense;
+    }
+    values.pop_back();
+    owners.pop_back();
+    sequence.pop_back();
+
+    ++slots[handle.index].generation;
+    freeSlots.push_back(handle.index);
+    ++revision;
+    return true;
+  }
+
+  bool Contains(SlotHandle handle) const {
+    return handle.index < slots.size() &&
+           slots[handle.index].generation == handle.generation &&
+           slots[handle.index].dense < values.size() &&
+           owners[slots[handle.index].dense] == handle.index;
+  }
+
+  // Element behind 'handle', or nullptr if it was erased.
+  T *Get(SlotHandle handle) {
+    return Contains(handle) ? &values[slots[handle.index].dense] : nullptr;
+  }
+  const T *Get(SlotHandle handle) const {
+    return Contains(handle) ? &values[slots[handle.index].dense] : nullptr;
+  }
+
+  // --- Insertion sequence numbers ---
+  // Numbers count up from 0 over the map's life (Clear() does not restart
+  // them), so the next Insert gets NextSequence().
+  static constexpr uint64_t NO_SEQUENCE = UINT64_MAX;
+
+  uint64_t NextSequence() const { return nextSequence; }
+
+  // Sequence number of the element behind 'handle', or NO_SEQUENCE if it
+  // was erased.
+  uint64_t Sequence(SlotHandle handle) const {
+    return Contains(handle) ? sequence[slots[handle.index].dense]
+                            : NO_SEQUENCE;
+  }
+
+  // Handle of the live element numbered 'number', or an empty handle.
+  SlotHandle Find(uint64_t number) const {
+    auto it = bySequence.find(number);
+    if (it == bySequence.end())
+      return {};
+    return {it->second, slots[it->second].generation};
+  }
+
+  // --- Dense access (0 <= i < Size()) ---
+  T &At(size_t i) { return values[i]; }
+  const T &At(size_t i) const { return values[i]; }
+  SlotHandle HandleAt(size_t i) const {
+    return {owners[i], slots[owners[i]].generation};
+  }
+
+  // Dense positions sorted by insertion (oldest first).
+  void InsertionOrder(std::vector<uint32_t> &out) const {
+    out.resize(values.size());
+    for (uint32_t i = 0; i < out.size(); ++i)
+      out[i] = i;
+    std::sort(out.begin(), out.end(), [this](uint32_t a, uint32_t b) {
+      return sequence[a] < sequence[b];
+    });
+  }
+
+  auto begin() { return values.begin(); }
+  auto end() { return values.end(); }
+  auto begin() const { return values.begin(); }
+  auto end() const { return values.end(); }
+
+private:
+  struct Slot {
+    uint32_t dense = 0; // Position in 'values' while live
+    uint32_t generation = 0;
+  };
+
+  std::vector<T> values;          // Dense
+  std::vector<uint32_t> owners;   // Dense -> slot
+  std::vector<uint64_t> sequence; // Dense -> insertion number
+  std::unordered_map<uint64_t, uint32_t> bySequence; // Live number -> slot
+  std::vector<Slot> slots;
+  std::vector<uint32_t> freeSlots;
+  uint64_t nextSequence = 0;
+  uint64_t revision = 0;
+};
@@ -1,11 +1,14 @@
 #pragma once
 
-#include <string>
+#include "genre.h"
+#include "stringpool.h"
+
+#include <string_view>
 
 struct Song {
-  std::string name;
-  std::string artist;
-  std::string genre;
+  StringId name;   // Interned (stringPool)
+  StringId artist; // Interned (stringPool)
+  Genre genre;
   double price;
   double quality;
   double hype; // 1.0 = Max, 0.0 = Dead
@@ -18,6 +21,8 @@ struct Song {
   double earnings = 0.0;
   float lifeTime = 0.0f;
 
-  Song(std::string _name, std::string _artist, std::string _genre,
+  Song(std::string_view _name, std::string_view _artist, Genre _genre,
        double _quality, int _fans, double _price);
+  Song(StringId _name, StringId _artist, Genre _genre, double _quality,
+       int _fans, double _price);
 };
\ No newline at end of file
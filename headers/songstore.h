@@ -0,0 +1,43 @@
+#pragma once
+
+#include "song.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Handle of a song in a SongStore. Stays valid until the song is removed.
+using SongId = uint32_t;
+
+// --- SONG STORE ---
+// Owns album tracks in one flat array; albums keep only the ids of their
+// tracks (4 bytes each) instead of full Song copies. Removed ids are reused
+// by later Adds, so the array never grows past the most tracks ever live
+// at once.
+//
+// A track's own stats columns are not advanced by the economy tick (the
+// album is simulated as one release); Attribute() splits the album's
+// totals across its tracks on demand.
+class SongStore {
+public:
+  SongId Add(const Song &song);
+  void Remove(SongId id);
+
+  const Song &operator[](SongId id) const { return songs[id]; }
+  Song &operator[](SongId id) { return songs[id]; }
+
+  size_t Size() const { return songs.size() - freeIds.size(); } // Live
+  void Reserve(size_t count) { songs.reserve(count); }
+  void Clear();
+
+  // Splits 'total' (an album's streams, sales or earnings) across its
+  // tracks: listeners replay the better songs, so each track's share is
+  // proportional to its quality. out[k] belongs to tracks[k]; the values
+  // add up to 'total'.
+  void Attribute(const std::vector<SongId> &tracks, double total,
+                 std::vector<double> &out) const;
+
+private:
+  std::vector<Song> songs;     // Indexed by id (free slots hold stale songs)
+  std::vector<SongId> freeIds; // Removed ids, reused last-in first-out
+};
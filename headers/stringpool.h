@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Handle of an interned string. 0 is always the empty string.
+using StringId = uint32_t;
+
+// --- STRING POOL ---
+// Interns release names and artists into an append-only arena and hands out
+// small stable handles, so a Song or Album stores 4 bytes per name and
+// copying one never copies text. Equal strings share one id.
+//
+// Strings are never freed. Names come from a small vocabulary (generated
+// titles, the player's name, album names typed in the UI), so the pool stays
+// small even over very long careers.
+//
+// Intern() is thread-safe (careers run in parallel). View() never locks:
+// text and directory entries are written before their id is published and
+// never move afterwards, so the UI can read while the simulation interns.
+class StringPool {
+public:
+  static constexpr size_t CHUNK_BYTES = 64 * 1024; // Arena chunk size
+  static constexpr size_t SEGMENT_SIZE = 4096;     // Directory segment
+  static constexpr size_t MAX_SEGMENTS = 4096;     // ~16.7M strings
+
+  StringPool();
+
+  StringPool(const StringPool &) = delete;
+  StringPool &operator=(const StringPool &) = delete;
+
+  // Id of 'text', adding it on first use.
+  StringId Intern(std::string_view text);
+
+  // Text of 'id' (NUL-terminated). Unknown ids read as "".
+  std::string_view View(StringId id) const;
+  const char *CStr(StringId id) const { return View(id).data(); }
+
+  size_t Count() const { return count.load(std::memory_order_acquire); }
+  size_t Bytes() const; // Arena bytes in use
+
+private:
+  // Copies 'text' (plus a NUL) into the arena. Caller holds 'mutex'.
+  const char *Store(std::string_view text);
+
+  mutable std::mutex mutex; // Guards everything below except 'count'
+  std::vector<std::unique_ptr<char[]>> chunks;
+  char *chunk = nullptr; // Current arena chunk
+  size_t chunkUsed = 0;
+  size_t bytes = 0;
+  std::unordered_map<std::string_view, StringId> ids;
+
+  // id -> text. Segments are allocated on demand and never move.
+  std::unique_ptr<std::string_view[]> segments[MAX_SEGMENTS];
+  std::atomic<uint32_t> count{0}; // Ids published so far
+};
+
+extern StringPool stringPool; // Global instance
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// --- PER-TICK TELEMETRY ---
+// One row per stepped economy tick, written to a columnar, append-only file:
+//
+//   TelemetryFileHeader | TelemetryColumn[columnCount] | block | block | ...
+//   block = TelemetryBlockHeader | column 0 values | column 1 values | ...
+//
+// Each block holds up to BLOCK_ROWS rows, every column stored contiguously
+// (8-byte aligned), so a reader can pull one column out of a long run
+// without touching the others. Blocks are only ever appended.
+//
+// The recorder keeps RING_BLOCKS blocks of rows preallocated. The tick only
+// copies one row into the ring; full blocks are transposed and written by a
+// background thread. Nothing allocates after Open().
+//
+// A span skipped by FastForwardEconomy is one row for its last tick with
+// ticksCovered = the span's length (state as of the end of the span), so
+// the tick column jumps by ticksCovered from the row before; stepped ticks
+// have ticksCovered = 1. Per-tick consumers must expand or weight span rows
+// rather than assume consecutive ticks.
+
+// What one economy tick looked like.
+struct TelemetryRow {
+  uint64_t tick = 0;
+  double money = 0.0;
+  double reputation = 0.0;  // After UpdateReputation, if it ran this tick
+  int64_t dailyStreams = 0; // Singles + albums
+  int32_t fans = 0;
+  uint32_t songs = 0;  // Live singles
+  uint32_t albums = 0; // Live albums
+  uint32_t ticksCovered = 1; // > 1: a fast-forwarded span ending at 'tick'
+  float trendMultiplier = 0.0f;
+  uint8_t trendGenre = 0;      // Genre id
+  uint8_t reputationCycle = 0; // 1 if UpdateReputation recomputed it
+};
+
+enum class TelemetryType : uint32_t { U8 = 1, I32, U32, I64, U64, F32, F64 };
+
+struct TelemetryFileHeader {
+  char magic[8]; // "MTYCTLM\0"
+  uint32_t version;
+  uint32_t columnCount;
+};
+
+struct TelemetryColumn {
+  char name[24]; // NUL-padded
+  uint32_t type; // TelemetryType
+  uint32_t size; // Bytes per value
+};
+
+struct TelemetryBlockHeader {
+  uint32_t magic; // BLOCK_MAGIC
+  uint32_t rowCount;
+  uint64_t firstTick;
+};
+
+class TelemetryRecorder {
+public:
+  static constexpr uint32_t VERSION = 2; // 2: ticksCovered
+  static constexpr uint32_t BLOCK_MAGIC = 0x4B4C4254; // "TBLK"
+  static constexpr size_t BLOCK_ROWS = 4096;
+  static constexpr size_t RING_BLOCKS = 4;
+
+  TelemetryRecorder() = default;
+  ~TelemetryRecorder();
+
+  TelemetryRecorder(const TelemetryRecorder &) = delete;
+  TelemetryRecorder &operator=(const TelemetryRecorder &) = delete;
+
+  // Creates (truncates) 'path', writes the header and starts the writer.
+  bool Open(const std::string &path, std::string &error);
+
+  // Writes the partial block, stops the writer and closes the file.
+  // Returns false if any write failed.
+  bool Close();
+
+  bool IsOpen() const { return file != nullptr; }
+
+  // --- Hot path (simulation thread only) ---
+
+  // Appends a row for a finished economy tick.
+  void Append(const TelemetryRow &row);
+
+  // Updates the reputation of the last appended row (UpdateReputation runs
+  // after the tick in the same frame).
+  void NoteReputation(double reputation);
+
+  uint64_t RowsWritten() const { return rowsWritten.load(); }
+
+private:
+  void SubmitCurrentBlock();
+  void WriterLoop();
+  bool WriteBlock(size_t block, size_t rows);
+
+  std::FILE *file = nullptr;
+  std::vector<TelemetryRow> ring; // RING_BLOCKS * BLOCK_ROWS rows
+  std::vector<unsigned char> columnScratch; // One transposed column
+
+  // Simulation thread
+  size_t currentBlock = 0;
+  size_t rowInBlock = 0;
+
+  // Hand-off (guarded by 'mutex')
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable freed;
+  size_t blockRows[RING_BLOCKS] = {}; // Rows in each submitted block
+  bool busy[RING_BLOCKS] = {};        // Submitted and not yet written
+  size_t nextToWrite = 0;             // Blocks are written in ring order
+  bool stopping = false;
+  bool failed = false;
+
+  std::atomic<uint64_t> rowsWritten{0};
+  std::thread writer;
+};
+
+// Prints a telemetry file as CSV (header line + one line per tick).
+bool DumpTelemetryCsv(const std::string &path, std::FILE *out,
+                      std::string &error);
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Minimal fork-join pool for data-parallel loops.
+// ParallelFor hands out task indices dynamically, so which thread runs a
+// task is not deterministic. Callers that need reproducible results must
+// make each task's output depend only on its index (e.g. fixed-size chunks
+// with per-task accumulators merged in index order).
+class ThreadPool {
+public:
+  // 0 = one thread per hardware core (the calling thread counts as one)
+  explicit ThreadPool(size_t threadCount = 0);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  // Number of threads that run tasks, including the caller.
+  size_t Size() const { return workers.size() + 1; }
+
+  // Runs fn(task) for every task in [0, taskCount) and blocks until all are
+  // done. The calling thread works too. Calls from inside a task run inline.
+  void ParallelFor(size_t taskCount, const std::function<void(size_t)> &fn);
+
+private:
+  void WorkerLoop();
+  void RunTasks();
+
+  std::vector<std::thread> workers;
+
+  std::mutex jobMutex; // One ParallelFor at a time
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable done;
+
+  const std::function<void(size_t)> *job = nullptr;
+  size_t jobSize = 0;
+  std::atomic<size_t> nextTask{0};
+  size_t generation = 0;
+  size_t pendingWorkers = 0;
+  bool stopping = false;
+};
+
+// Process-wide pool shared by the simulation (created on first use).
+ThreadPool &SharedThreadPool();
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// --- TRACKLIST OPTIMIZER ---
+// Finds the subset of candidate songs (e.g. the vault) with the highest
+// album quality, for a fixed track count or the best count in a range.
+//
+// Branch and bound over the candidates ranked best first: a partial
+// tracklist is only extended while the best album it could still become
+// beats the best one found so far. That bound takes the next-best
+// candidates for the open spots (the highest weighted base any completion
+// can have), the cohesion modifier at the lowest spread any completion can
+// have, and no filler penalty. Equal qualities are interchangeable, so only
+// one of each group of equal candidates is ever tried per spot. The first
+// pick is handed out across the shared thread pool; the searches share the
+// best quality found.
+//
+// The quality found does not depend on the thread count, but if several
+// tracklists reach it, which one is returned may.
+
+constexpr size_t TRACKLIST_MAX_TRACKS = 30; // Default upper end of a range
+
+struct TracklistOptions {
+  size_t minTracks = 1; // Equal to maxTracks for a fixed count
+  size_t maxTracks = TRACKLIST_MAX_TRACKS;
+  double budgetMs = 80.0; // Wall time; the best so far is returned after it
+};
+
+struct TracklistResult {
+  std::vector<uint32_t> tracks; // Candidate indices, best quality first
+  double quality = 0.0;         // Player::CalcAlbumQuality of 'tracks'
+  bool exact = false;           // Search finished: nothing beats 'quality'
+  uint64_t nodes = 0;           // Partial tracklists visited
+};
+
+// Empty result if there are fewer than options.minTracks candidates.
+TracklistResult FindBestTracklist(const std::vector<double> &qualities,
+                                  const TracklistOptions &options = {});
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Simulation.h"
+#include "catalog.h"
+#include "eventlog.h"
+#include "genre.h"
+#include "player.h"
+#include "rng.h"
+#include "slotmap.h"
+#include "song.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// One self-contained career: player, catalogs, clock, market/economy state,
+// random streams and vault. Nothing in a World is shared with another World,
+// so any number of them can run side by side (one per thread). Only the log
+// is external, so the app can point it at gameLog.
+struct World {
+  uint64_t seed;
+  Player player;
+  SlotMap<Song> vault; // Recorded but unreleased songs
+  ReleaseCatalog songs{false};
+  ReleaseCatalog albums{true};
+
+  // Drives market trend cycles and the reputation cycle
+  std::shared_ptr<float> clock = std::make_shared<float>(0.0f);
+
+  EconomyState economy;
+
+  // Session stream for draws outside the economy tick (recording, names).
+  // Install it with Random::StreamScope before calling Player/helper code.
+  RandomStream rng;
+
+  EventLog *log = nullptr; // Where events go (nullptr = dropped)
+
+  TickMode mode = TickMode::Serial;
+
+  explicit World(uint64_t worldSeed, std::string artist = "Headless Artist");
+};
+
+// Advances a world by 'dt' seconds: economy, reputation, then expiry.
+// Same order as the app's frame loop.
+void StepWorld(World &world, float dt);
+
+// Advances a world by 'ticks' economy ticks, skipping idle stretches with
+// FastForwardEconomy and stepping the rest one tick at a time. Spans are
+// statistically (not bit-for-bit) equivalent to stepping; nothing is logged
+// inside them.
+void FastForwardWorld(World &world, uint64_t ticks);
+
+// --- PLAYER ACTIONS ---
+// What the studio buttons do. Messages go to world.log. Each returns false
+// if nothing changed (not enough energy or money, a song no longer in the
+// vault, bad index).
+
+// Records a song into the vault (costs 5 energy; quality is rolled).
+bool RecordSong(World &world, const std::string &name, Genre genre);
+
+// Moves a vault song to the singles catalog.
+bool ReleaseSingle(World &world, SlotHandle song);
+
+// Releases the given vault songs (in track order) as one album and removes
+// them from the vault (costs 10 energy). Nothing happens unless every song
+// is still in the vault.
+bool ReleaseAlbum(World &world, const std::string &name,
+                  const std::vector<SlotHandle> &tracks);
+
+// Raises a skill (skill = true) or studio tool by 'gain' for 'cost'.
+bool BuyUpgrade(World &world, bool skill, size_t index, double cost,
+                double gain);
@@ -1,10 +1,10 @@
 #include "../headers/album.h"
 
-Album::Album(std::string _name, std::string _artist, std::string _genre,
+Album::Album(std::string_view _name, std::string_view _artist, Genre _genre,
              std::vector<Song> _tracks, double _quality, int _currentFans,
              double _price = 9.99)
-    : name(std::move(_name)), artist(std::move(_artist)),
-      genre(std::move(_genre)),
+    : name(stringPool.Intern(_name)), artist(stringPool.Intern(_artist)),
+      genre(_genre),
       tracks(std::move(_tracks)), // Correctly move the vector into the struct
       price(_price), quality(_quality) {
 
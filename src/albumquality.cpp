@@ -0,0 +1,364 @@
+#include "../headers/albumquality.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace {
+
+// Adds 'x' to the compensated sum 'hi + lo' (TwoSum, then renormalized).
+void AddCompensated(double &hi, double &lo, double x) {
+  double s = hi + x;
+  double b = s - hi;
+  lo += (hi - (s - b)) + (x - b);
+  hi = s + lo;
+  lo -= hi - s;
+}
+
+// Adds 'sign' x q^2 to 'hi + lo', both halves of the exact square.
+void AddSquare(double &hi, double &lo, double q, double sign) {
+  double square = q * q;
+  AddCompensated(hi, lo, sign * square);
+  AddCompensated(hi, lo, sign * std::fma(q, q, -square));
+}
+
+} // namespace
+
+// ----------------------------------------------------------------------------
+// REFERENCE
+// ----------------------------------------------------------------------------
+
+double AlbumQualityOfSorted(const std::vector<double> &sortedSongs) {
+  // 1. Safety check
+  if (sortedSongs.empty())
+    return 0.0;
+
+  // 2. Weighted Average (The "Hit Single" Effect)
+  // Realism: Listeners value the "Highs" of an album more than the "Lows".
+  // We use a gentle decay so the top 3-4 songs drive the score,
+  // but the 'tail' still matters.
+  double weightedSum = 0.0;
+  double totalWeight = 0.0;
+
+  for (size_t i = 0; i < sortedSongs.size(); ++i) {
+    // Decay: 100%, 85%, 72%... floor at 25% weight.
+    // This ensures even the last track contributes 25% of its value to the
+    // average.
+    double weight = std::max(0.25, std::pow(0.85, static_cast<double>(i)));
+    weightedSum += sortedSongs[i] * weight;
+    totalWeight += weight;
+  }
+
+  // This is our starting point.
+  // If inputs are [10, 20, 10, 20, 15], this will naturally settle around ~16.
+  double baseQuality = weightedSum / totalWeight;
+
+  // 3. Cohesion (Standard Deviation)
+  // Realism: An album with wild quality swings (90, 10, 90, 10) feels
+  // disjointed. An album of all 50s feels cohesive.
+  double sum = std::accumulate(sortedSongs.begin(), sortedSongs.end(), 0.0);
+  double mean = sum / static_cast<double>(sortedSongs.size());
+
+  double sqDiffSum = 0.0;
+  for (double q : sortedSongs) {
+    double diff = q - mean;
+    sqDiffSum += diff * diff;
+  }
+
+  // Variance logic
+  double variance =
+      (sortedSongs.size() > 1)
+          ? sqDiffSum / static_cast<double>(sortedSongs.size() - 1)
+          : 0.0;
+  double stdev = std::sqrt(std::max(0.0, variance));
+  double cohesionModifier = AlbumCohesion(stdev);
+
+  // 4. Dynamic Filler Penalty
+  // Realism: "Filler" isn't just "Bad songs". It's songs that ruin the specific
+  // album. If the Average is 15, a 10 IS NOT FILLER. It fits the vibe. If the
+  // Average is 80, a 40 IS FILLER.
+  double fillerPenalty = 0.0;
+
+  // We only check for filler if the album claims to be decent (> 40 avg)
+  // This PROTECTS your low-quality 10-20 album from being penalized.
+  if (sortedSongs.size() >= ALBUM_FILLER_MIN_TRACKS &&
+      baseQuality > ALBUM_FILLER_MIN_BASE) {
+    double fillerThreshold =
+        baseQuality * ALBUM_FILLER_SHARE; // Filler is 60% of average or less
+    int fillerCount = 0;
+
+    for (double q : sortedSongs) {
+      if (q < fillerThreshold)
+        ++fillerCount;
+    }
+
+    // Only punish if it's a significant portion of the album (> 25%)
+    if (fillerCount > (sortedSongs.size() * 0.25)) {
+      fillerPenalty = fillerCount * 2.0; // -2 per filler track
+    }
+  }
+
+  // 5. Length bonus, 6. Final, 7. Soft caps
+  return AlbumSoftCap(baseQuality + cohesionModifier +
+                      AlbumLengthBonus(sortedSongs.size()) - fillerPenalty);
+}
+
+// ----------------------------------------------------------------------------
+// FORMULA
+// ----------------------------------------------------------------------------
+
+double AlbumBaseQuality(const AlbumStats &stats) {
+  // Weighted Average (The "Hit Single" Effect)
+  // Realism: Listeners value the "Highs" of an album more than the "Lows".
+  // We use a gentle decay so the top 3-4 songs drive the score,
+  // but the 'tail' still matters.
+  // Decay: 100%, 85%, 72%... floor at 25% weight.
+  // This ensures even the last track contributes 25% of its value to the
+  // average.
+  size_t head = std::min(stats.count, ALBUM_HEAD);
+  double headSum = 0.0;
+  double weightedSum = 0.0;
+  double totalWeight = 0.0;
+  for (size_t i = 0; i < head; ++i) {
+    headSum += stats.head[i];
+    weightedSum += stats.head[i] * ALBUM_WEIGHTS[i];
+    totalWeight += ALBUM_WEIGHTS[i];
+  }
+
+  // Every track past the head weighs the same
+  size_t tail = stats.count - head;
+  weightedSum += ((stats.sum - headSum) + stats.sumError) * ALBUM_TAIL_WEIGHT;
+  totalWeight += static_cast<double>(tail) * ALBUM_TAIL_WEIGHT;
+
+  // If inputs are [10, 20, 10, 20, 15], this will naturally settle around ~16.
+  return weightedSum / totalWeight;
+}
+
+double AlbumStdev(const AlbumStats &stats) {
+  if (stats.count < 2)
+    return 0.0;
+  const double n = static_cast<double>(stats.count);
+
+  // Squared deviations from the rounded mean m, expanded so that nothing
+  // large cancels in plain doubles:
+  //   sum (q - m)^2 = sumSquares - m x sum - m x (sum - n x m)
+  double m = stats.sum / n;
+  double nm = n * m;
+  double excess = ((stats.sum - nm) - std::fma(n, m, -nm)) + stats.sumError;
+  double msum = m * stats.sum;
+  double msumError = std::fma(m, stats.sum, -msum) + m * stats.sumError;
+  double sqDiffSum = (stats.sumSquares - msum) +
+                     (stats.sumSquaresError - msumError) - m * excess;
+  return std::sqrt(std::max(0.0, sqDiffSum) / (n - 1.0));
+}
+
+double AlbumCohesion(double stdev) {
+  // Cohesion Logic:
+  // - High Stdev (e.g. > 15) -> Penalty (Disjointed)
+  // - Low Stdev (e.g. < 5)  -> Bonus (Consistent flow)
+  // Note: We scale this impact. It matters less for low-quality albums.
+  // A consistent 15/100 album is still just a 15, not a 20.
+  if (stdev < ALBUM_COHESION_MAX_STDEV)
+    return 2.0; // Small bonus for tight consistency
+  if (stdev > 15.0) {
+    // Penalty scales with how "good" the album tries to be.
+    // If base is 80 and stdev is 20, penalty is noticeable (-4).
+    // If base is 15 and stdev is 5 (irrelevant), penalty is tiny.
+    return -(stdev - 15.0) * 0.25;
+  }
+  return 0.0;
+}
+
+double AlbumLengthBonus(size_t count) {
+  // Length Bonus (The "LP" Effect)
+  // Realism: Critics respect a 12-track project more than a 6-track one,
+  // provided the quality holds up.
+  if (count >= 14)
+    return 3.5;
+  if (count >= 10)
+    return 2.0;
+  return 0.0;
+}
+
+double AlbumSoftCap(double rawQuality) {
+  // Soft Caps (Diminishing Returns)
+  // It is exponentially harder to go from 90->95 than 50->55.
+  if (rawQuality > 90.0)
+    rawQuality = 90.0 + (rawQuality - 90.0) * 0.5;
+  return std::clamp(rawQuality, 1.0, 100.0);
+}
+
+double AlbumFinalQuality(const AlbumStats &stats, double base,
+                         size_t fillerCount) {
+  const double n = static_cast<double>(stats.count);
+
+  // 1. Cohesion (Standard Deviation)
+  // Realism: An album with wild quality swings (90, 10, 90, 10) feels
+  // disjointed. An album of all 50s feels cohesive.
+  double cohesionModifier = AlbumCohesion(AlbumStdev(stats));
+
+  // 2. Dynamic Filler Penalty
+  // Realism: "Filler" isn't just "Bad songs". It's songs that ruin the specific
+  // album. If the Average is 15, a 10 IS NOT FILLER. It fits the vibe. If the
+  // Average is 80, a 40 IS FILLER. Only albums that claim to be decent are
+  // checked, which PROTECTS a low-quality 10-20 album from being penalized.
+  // Only punish if it's a significant portion of the album (> 25%).
+  double fillerPenalty = 0.0;
+  if (stats.count >= ALBUM_FILLER_MIN_TRACKS && base > ALBUM_FILLER_MIN_BASE &&
+      fillerCount > (n * 0.25)) {
+    fillerPenalty = static_cast<double>(fillerCount) * 2.0; // -2 per track
+  }
+
+  // 3. Length bonus, 4. Final, 5. Soft caps
+  return AlbumSoftCap(base + cohesionModifier + AlbumLengthBonus(stats.count) -
+                      fillerPenalty);
+}
+
+// ----------------------------------------------------------------------------
+// INCREMENTAL MODEL
+// ----------------------------------------------------------------------------
+
+void AlbumQualityModel::Reset(const std::vector<double> &qualities) {
+  const size_t n = qualities.size();
+  quality = qualities;
+
+  // Rank once: best first (ties: lower candidate first)
+  std::vector<uint32_t> order(n);
+  std::iota(order.begin(), order.end(), 0u);
+  std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+    if (qualities[a] != qualities[b])
+      return qualities[a] > qualities[b];
+    return a < b;
+  });
+
+  rankOf.resize(n);
+  byRank.resize(n);
+  for (size_t r = 0; r < n; ++r) {
+    rankOf[order[r]] = static_cast<uint32_t>(r);
+    byRank[r] = qualities[order[r]];
+  }
+
+  selected.assign(n, 0);
+  tree.assign(n + 1, 0);
+  count = 0;
+  sum = sumError = 0.0;
+  sumSquares = sumSquaresError = 0.0;
+}
+
+void AlbumQualityModel::Select(size_t candidate, bool on) {
+  if (candidate >= selected.size() || (selected[candidate] != 0) == on)
+    return;
+  selected[candidate] = on ? 1 : 0;
+
+  // 1. Fenwick update over the candidate's rank
+  uint32_t delta = on ? 1u : ~0u; // +1 / -1 (mod 2^32)
+  for (size_t i = rankOf[candidate] + 1; i < tree.size(); i += i & (~i + 1))
+    tree[i] += delta;
+
+  // 2. Running sums, compensated so that no toggle history drifts them
+  // (exactly zero again once nothing is selected)
+  double q = quality[candidate];
+  if (on) {
+    ++count;
+    AddCompensated(sum, sumError, q);
+    AddSquare(sumSquares, sumSquaresError, q, 1.0);
+  } else if (--count == 0) {
+    sum = sumError = 0.0;
+    sumSquares = sumSquaresError = 0.0;
+  } else {
+    AddCompensated(sum, sumError, -q);
+    AddSquare(sumSquares, sumSquaresError, q, -1.0);
+  }
+}
+
+void AlbumQualityModel::ClearSelection() {
+  std::fill(selected.begin(), selected.end(), 0);
+  std::fill(tree.begin(), tree.end(), 0);
+  count = 0;
+  sum = sumError = 0.0;
+  sumSquares = sumSquaresError = 0.0;
+}
+
+size_t AlbumQualityModel::SelectedBefore(size_t rank) const {
+  size_t total = 0;
+  for (size_t i = rank; i > 0; i -= i & (~i + 1))
+    total += tree[i];
+  return total;
+}
+
+size_t AlbumQualityModel::NthSelected(size_t n) const {
+  // Binary lifting: the largest prefix holding at most n selected ranks
+  size_t pos = 0;
+  size_t step = 1;
+  while (step * 2 < tree.size())
+    step *= 2;
+  for (; step > 0; step /= 2) {
+    if (pos + step < tree.size() && tree[pos + step] <= n) {
+      pos += step;
+      n -= tree[pos];
+    }
+  }
+  return pos; // 0-based rank
+}
+
+AlbumStats AlbumQualityModel::Stats() const {
+  AlbumStats stats;
+  stats.count = count;
+  stats.sum = sum;
+  stats.sumSquares = sumSquares;
+  stats.sumError = sumError;
+  stats.sumSquaresError = sumSquaresError;
+  size_t head = std::min(count, ALBUM_HEAD);
+  for (size_t i = 0; i < head; ++i)
+    stats.head[i] = byRank[NthSelected(i)];
+  return stats;
+}
+
+size_t AlbumQualityModel::SelectedBelow(double threshold) const {
+  // Qualities below the threshold occupy a suffix of the ranks
+  size_t first = static_cast<size_t>(
+      std::partition_point(byRank.begin(), byRank.end(),
+                           [threshold](double q) { return q >= threshold; }) -
+      byRank.begin());
+  return count - SelectedBefore(first);
+}
+
+double AlbumQualityModel::Exact() const {
+  std::vector<double> sortedSongs(count);
+  for (size_t i = 0; i < count; ++i)
+    sortedSongs[i] = byRank[NthSelected(i)];
+  return AlbumQualityOfSorted(sortedSongs);
+}
+
+double AlbumQualityModel::Estimate() const {
+  if (count == 0)
+    return 0.0;
+
+  // 1. Base and spread from the sums
+  AlbumStats stats = Stats();
+  double base = AlbumBaseQuality(stats);
+  double stdev = AlbumStdev(stats);
+
+  // 2. Any cut-off within rounding goes to the reference, so that the
+  // decisions are always CalcAlbumQuality's
+  auto Near = [](double value, double cutoff) {
+    return std::abs(value - cutoff) <= cutoff * ALBUM_NEAR_CUTOFF;
+  };
+  if (Near(stdev, ALBUM_COHESION_MAX_STDEV))
+    return Exact();
+  size_t fillerCount = 0;
+  if (count >= ALBUM_FILLER_MIN_TRACKS) {
+    if (Near(base, ALBUM_FILLER_MIN_BASE))
+      return Exact();
+    if (base > ALBUM_FILLER_MIN_BASE) {
+      double threshold = base * ALBUM_FILLER_SHARE;
+      double margin = threshold * ALBUM_NEAR_CUTOFF;
+      fillerCount = SelectedBelow(threshold - margin);
+      if (SelectedBelow(threshold + margin) != fillerCount)
+        return Exact();
+    }
+  }
+
+  // 3. Clear of every cut-off: the rest only rounds differently
+  return AlbumFinalQuality(stats, base, fillerCount);
+}
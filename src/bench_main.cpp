@@ -0,0 +1,672 @@
+// Microbenchmarks for the simulation hot paths.
+// Every benchmark runs its body in timed batches until --min-time is spent,
+// repeats that --repeat times and keeps the fastest run. Heap allocations
+// are counted by replacing the global operator new in this executable, so
+// "allocs/op" covers everything the measured code allocates (including
+// work done on pool threads).
+//
+// Results go to stdout as a table, and optionally as JSON (--json) or CSV
+// (--csv) so runs on different commits or machines can be compared.
+
+#include "../headers/Simulation.h"
+#include "../headers/album.h"
+#include "../headers/albumquality.h"
+#include "../headers/catalog.h"
+#include "../headers/config.h"
+#include "../headers/curves.h"
+#include "../headers/helper.h"
+#include "../headers/performance.h"
+#include "../headers/player.h"
+#include "../headers/rng.h"
+#include "../headers/song.h"
+#include "../headers/threadpool.h"
+#include "../headers/tracklist.h"
+#include "../headers/world.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// ALLOCATION COUNTING
+// ----------------------------------------------------------------------------
+
+namespace {
+std::atomic<uint64_t> allocCount{0};
+std::atomic<uint64_t> allocBytes{0};
+
+void *CountedAlloc(std::size_t size) {
+  allocCount.fetch_add(1, std::memory_order_relaxed);
+  allocBytes.fetch_add(size, std::memory_order_relaxed);
+  if (void *ptr = std::malloc(size ? size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+} // namespace
+
+void *operator new(std::size_t size) { return CountedAlloc(size); }
+void *operator new[](std::size_t size) { return CountedAlloc(size); }
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchOptions {
+  double minTime = 0.2; // Seconds per timed run
+  int repeat = 3;       // Timed runs per benchmark (fastest is kept)
+  long long maxReleases = 1000000;
+  std::string filter; // Only run benchmarks whose name contains this
+  std::string jsonPath;
+  std::string csvPath;
+  uint64_t seed = Random::DEFAULT_SEED;
+  SimdLevel simd = DetectSimdLevel();
+  CurveMode curves = GetCurveMode();
+};
+
+struct BenchResult {
+  std::string name;
+  uint64_t iterations = 0; // In the fastest run
+  double nsPerOp = 0.0;
+  double itemsPerOp = 0.0; // Work units per op (releases, tracks, ...)
+  double allocsPerOp = 0.0;
+  double bytesPerOp = 0.0;
+};
+
+// Runs 'iterations' ops and returns the nanoseconds spent in them. Setup
+// that must not be timed (resetting state between batches) stays outside
+// the returned figure.
+using BenchBody = std::function<double(uint64_t iterations)>;
+
+struct Benchmark {
+  std::string name;
+  double itemsPerOp;
+  BenchBody body;
+};
+
+double ElapsedNs(Clock::time_point start) {
+  return std::chrono::duration<double, std::nano>(Clock::now() - start)
+      .count();
+}
+
+BenchResult Measure(const Benchmark &bench, const BenchOptions &opt) {
+  const double targetNs = opt.minTime * 1e9;
+
+  // 1. Calibrate: grow the batch until one run takes ~minTime
+  uint64_t iterations = 1;
+  while (true) {
+    double ns = bench.body(iterations);
+    if (ns >= targetNs || iterations >= (uint64_t{1} << 40))
+      break;
+    double scale = ns > 0.0 ? targetNs / ns * 1.2 : 10.0;
+    scale = std::clamp(scale, 1.5, 10.0);
+    iterations = static_cast<uint64_t>(iterations * scale) + 1;
+  }
+
+  // 2. Timed runs, keep the fastest
+  BenchResult result;
+  result.name = bench.name;
+  result.itemsPerOp = bench.itemsPerOp;
+  result.iterations = iterations;
+  result.nsPerOp = -1.0;
+
+  for (int run = 0; run < std::max(1, opt.repeat); ++run) {
+    uint64_t countBefore = allocCount.load();
+    uint64_t bytesBefore = allocBytes.load();
+    double ns = bench.body(iterations);
+    double nsPerOp = ns / static_cast<double>(iterations);
+
+    if (result.nsPerOp < 0.0 || nsPerOp < result.nsPerOp) {
+      double runs = static_cast<double>(iterations);
+      result.nsPerOp = nsPerOp;
+      result.allocsPerOp = (allocCount.load() - countBefore) / runs;
+      result.bytesPerOp = (allocBytes.load() - bytesBefore) / runs;
+    }
+  }
+  return result;
+}
+
+// Keeps the optimizer from dropping a result.
+template <typename T> void DoNotOptimize(const T &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// --- Catalog fixtures ---
+
+// A world with 'count' singles of mixed quality, genre and age, of which
+// 'deadShare' have already faded out (a late-game catalog).
+struct EconomyFixture {
+  World world;
+  ReleaseCatalog songs{false}; // Release-time catalog, restored per batch
+  int fans;
+  double money;
+
+  EconomyFixture(uint64_t seed, size_t count, double deadShare = 0.0)
+      : world(seed) {
+    Random::StreamScope scope(world.rng);
+    world.player.fans = 5000;
+    world.player.reputation = 20.0;
+
+    world.songs.Reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      double quality = Random::Double(5.0, 95.0);
+      Song song("Bench Song", world.player.name,
+                GenreAt(i % GENRE_COUNT), quality, world.player.fans,
+                GetRecommendedPrice(quality, false));
+      world.songs.Add(song);
+      // Spread the catalog over a song's lifetime
+      world.songs.lifeTime.back() = static_cast<float>(
+          Random::Double(0.0, EconomyConfig::SONG_LIFETIME * 0.9));
+      if (deadShare > 0.0 && Random::Chance(deadShare))
+        world.songs.hype.back() = 0.0;
+    }
+    world.songs.RebuildIndex();
+
+    songs = world.songs;
+    fans = world.player.fans;
+    money = world.player.money;
+  }
+
+  // Back to the release-time state so every batch measures the same load.
+  void Reset() {
+    world.songs = songs; // Reuses capacity; demotions reorder the columns
+    world.player.fans = fans;
+    world.player.money = money;
+  }
+};
+
+// Economy ticks between fixture resets (hype decays, songs age).
+constexpr uint64_t RESET_EVERY = 64;
+
+// Share of dormant releases in the "late" catalogs.
+constexpr double LATE_DEAD_SHARE = 0.9;
+
+Benchmark EconomyBenchmark(const BenchOptions &opt, size_t count,
+                           TickMode mode, bool late = false) {
+  auto fixture = std::make_shared<EconomyFixture>(
+      opt.seed, count, late ? LATE_DEAD_SHARE : 0.0);
+  std::string kind = mode == TickMode::Parallel ? "parallel/" : "serial/";
+  if (late)
+    kind = "late/";
+  std::string name = "SimulateEconomy/" + kind + std::to_string(count);
+
+  // One call = one economy tick
+  return {name, static_cast<double>(count), [fixture, mode](uint64_t n) {
+            World &world = fixture->world;
+            double ns = 0.0;
+            for (uint64_t done = 0; done < n;) {
+              fixture->Reset();
+              uint64_t batch = std::min(RESET_EVERY, n - done);
+
+              auto start = Clock::now();
+              for (uint64_t i = 0; i < batch; ++i) {
+                SimulateEconomy(world.economy, world.songs, world.albums,
+                                world.player,
+                                EconomyConfig::ECONOMY_TICK_RATE,
+                                *world.clock, nullptr, mode);
+              }
+              ns += ElapsedNs(start);
+              done += batch;
+            }
+            return ns;
+          }};
+}
+
+Benchmark ReputationBenchmark(const BenchOptions &opt, size_t count) {
+  auto fixture = std::make_shared<EconomyFixture>(opt.seed, count);
+
+  // A clock step of one full cycle makes every call recompute (O(1): the
+  // catalog size should not show)
+  return {"UpdateReputation/" + std::to_string(count), 1.0,
+          [fixture](uint64_t n) {
+            World &world = fixture->world;
+            *world.clock = EconomyConfig::REP_CYCLE;
+            world.player.repUpdateAccumulator = 0.0f;
+
+            auto start = Clock::now();
+            for (uint64_t i = 0; i < n; ++i) {
+              UpdateReputation(world.player, world.songs, world.albums,
+                               world.clock);
+            }
+            double ns = ElapsedNs(start);
+            DoNotOptimize(world.player.reputation);
+            return ns;
+          }};
+}
+
+// The per-frame expiry check when nothing is due (the common case).
+Benchmark ExpiryBenchmark(const BenchOptions &opt, size_t count) {
+  auto fixture = std::make_shared<EconomyFixture>(opt.seed, count);
+
+  return {"RemoveExpired/idle/" + std::to_string(count), 1.0,
+          [fixture](uint64_t n) {
+            ReleaseCatalog &songs = fixture->world.songs;
+            size_t removed = 0;
+
+            auto start = Clock::now();
+            for (uint64_t i = 0; i < n; ++i)
+              removed += songs.RemoveExpired(EconomyConfig::SONG_LIFETIME);
+            double ns = ElapsedNs(start);
+            DoNotOptimize(removed);
+            return ns;
+          }};
+}
+
+// Pre-drawn inputs, cycled through by the cheap per-call benchmarks.
+constexpr size_t INPUT_COUNT = 1024;
+
+Benchmark FanbaseBenchmark(const BenchOptions &opt) {
+  struct Input {
+    int streams;
+    double quality;
+    double hype;
+  };
+  auto inputs = std::make_shared<std::vector<Input>>(INPUT_COUNT);
+  RandomStream rng(opt.seed, RngStream::Session, 1);
+  {
+    Random::StreamScope scope(rng);
+    for (Input &input : *inputs) {
+      input.streams = Random::Int(0, 20000);
+      input.quality = Random::Double(1.0, 100.0);
+      input.hype = Random::Double(0.0, 10.0);
+    }
+  }
+
+  auto stream = std::make_shared<RandomStream>(opt.seed, RngStream::Session, 2);
+  return {"UpdateFanbase", 1.0, [inputs, stream](uint64_t n) {
+            Player player("Bench Artist");
+            Random::StreamScope scope(*stream);
+
+            auto start = Clock::now();
+            for (uint64_t i = 0; i < n; ++i) {
+              const Input &input = (*inputs)[i % INPUT_COUNT];
+              // Keep the fanbase in a realistic range
+              if ((i % INPUT_COUNT) == 0) {
+                player.fans = 5000;
+                player.reputation = 20.0;
+              }
+              UpdateFanbase(player, input.streams, input.quality, input.hype);
+            }
+            double ns = ElapsedNs(start);
+            DoNotOptimize(player.fans);
+            return ns;
+          }};
+}
+
+// Cached (what the UI and bots pay per frame) or 'dirty': a level changes
+// before every call, so each one recomputes.
+Benchmark BaseQualityBenchmark(bool dirty) {
+  return {dirty ? "GetBaseQuality/dirty" : "GetBaseQuality", 1.0,
+          [dirty](uint64_t n) {
+            Player player("Bench Artist");
+            double sum = 0.0;
+
+            auto start = Clock::now();
+            for (uint64_t i = 0; i < n; ++i) {
+              if (dirty)
+                player.SetSkillLevel(Skill::Mixing, 0.3 + (i & 7) * 0.1);
+              sum += player.GetBaseQuality();
+              DoNotOptimize(sum);
+            }
+            return ElapsedNs(start);
+          }};
+}
+
+Benchmark AlbumQualityBenchmark(const BenchOptions &opt, size_t tracks) {
+  // INPUT_COUNT different tracklists of 'tracks' songs each
+  auto qualities = std::make_shared<std::vector<std::vector<double>>>();
+  RandomStream rng(opt.seed, RngStream::Session, 3 + tracks);
+  {
+    Random::StreamScope scope(rng);
+    for (size_t i = 0; i < INPUT_COUNT; ++i) {
+      std::vector<double> list(tracks);
+      for (double &quality : list)
+        quality = Random::Double(5.0, 95.0);
+      qualities->push_back(std::move(list));
+    }
+  }
+
+  return {"CalcAlbumQuality/" + std::to_string(tracks),
+          static_cast<double>(tracks), [qualities](uint64_t n) {
+            Player player("Bench Artist");
+            double sum = 0.0;
+
+            auto start = Clock::now();
+            for (uint64_t i = 0; i < n; ++i) {
+              sum += player.CalcAlbumQuality((*qualities)[i % INPUT_COUNT]);
+              DoNotOptimize(sum);
+            }
+            return ElapsedNs(start);
+          }};
+}
+
+// The Album Workshop path: a vault of 'candidates' songs, one checkbox
+// toggled and the estimate re-read per op.
+Benchmark AlbumModelBenchmark(const BenchOptions &opt, size_t candidates) {
+  auto qualities = std::make_shared<std::vector<double>>(candidates);
+  auto toggles = std::make_shared<std::vector<uint32_t>>(INPUT_COUNT);
+  RandomStream rng(opt.seed, RngStream::Session, 5 + candidates);
+  {
+    Random::StreamScope scope(rng);
+    for (double &quality : *qualities)
+      quality = Random::Double(5.0, 95.0);
+    for (uint32_t &toggle : *toggles)
+      toggle = static_cast<uint32_t>(
+          Random::Int(0, static_cast<int>(candidates) - 1));
+  }
+
+  return {"AlbumQualityModel/toggle/" + std::to_string(candidates), 1.0,
+          [qualities, toggles](uint64_t n) {
+            AlbumQualityModel model;
+            model.Reset(*qualities);
+            double sum = 0.0;
+
+            auto start = Clock::now();
+            for (uint64_t i = 0; i < n; ++i) {
+              size_t candidate = (*toggles)[i % INPUT_COUNT];
+              model.Select(candidate, !model.IsSelected(candidate));
+              sum += model.Estimate();
+              DoNotOptimize(sum);
+            }
+            return ElapsedNs(start);
+          }};
+}
+
+// "Suggest Tracklist" over a vault of 'candidates' songs recorded at one
+// skill level (base 55, noise and the odd viral take), any track count.
+Benchmark TracklistBenchmark(const BenchOptions &opt, size_t candidates) {
+  auto qualities = std::make_shared<std::vector<double>>(candidates);
+  RandomStream rng(opt.seed, RngStream::Session, 6 + candidates);
+  {
+    Random::StreamScope scope(rng);
+    for (double &quality : *qualities) {
+      quality = 55.0 + Random::Normal(0.0, 5.0);
+      if (Random::Double(0.0, 100.0) > 99.0)
+        quality += 20.0;
+      quality = std::clamp(quality, 1.0, 100.0);
+    }
+  }
+
+  return {"FindBestTracklist/" + std::to_string(candidates),
+          static_cast<double>(candidates), [qualities](uint64_t n) {
+            double sum = 0.0;
+
+            auto start = Clock::now();
+            for (uint64_t i = 0; i < n; ++i) {
+              TracklistResult best = FindBestTracklist(*qualities);
+              sum += best.quality;
+              DoNotOptimize(sum);
+            }
+            return ElapsedNs(start);
+          }};
+}
+
+Benchmark SongNameBenchmark(const BenchOptions &opt) {
+  auto stream = std::make_shared<RandomStream>(opt.seed, RngStream::Session, 4);
+  return {"GenerateSongName", 1.0, [stream](uint64_t n) {
+            Random::StreamScope scope(*stream);
+            size_t length = 0;
+
+            auto start = Clock::now();
+            for (uint64_t i = 0; i < n; ++i) {
+              std::string name = GenerateSongName();
+              length += name.size();
+              DoNotOptimize(length);
+            }
+            return ElapsedNs(start);
+          }};
+}
+
+// A benchmark by name; the fixture is only built when it runs (the large
+// catalogs take a while to fill and should not all be alive at once).
+struct BenchEntry {
+  std::string name;
+  std::function<Benchmark()> make;
+};
+
+std::vector<BenchEntry> BuildSuite(const BenchOptions &opt) {
+  std::vector<BenchEntry> suite;
+  const size_t maxReleases = static_cast<size_t>(opt.maxReleases);
+
+  for (size_t count = 100; count <= maxReleases; count *= 10) {
+    suite.push_back({"SimulateEconomy/serial/" + std::to_string(count),
+                     [&opt, count] {
+                       return EconomyBenchmark(opt, count, TickMode::Serial);
+                     }});
+  }
+  for (size_t count = 100; count <= maxReleases; count *= 10) {
+    suite.push_back({"SimulateEconomy/late/" + std::to_string(count),
+                     [&opt, count] {
+                       return EconomyBenchmark(opt, count, TickMode::Serial,
+                                               true);
+                     }});
+  }
+  for (size_t count = 10000; count <= maxReleases; count *= 10) {
+    suite.push_back({"SimulateEconomy/parallel/" + std::to_string(count),
+                     [&opt, count] {
+                       return EconomyBenchmark(opt, count, TickMode::Parallel);
+                     }});
+  }
+  for (size_t count = 100; count <= maxReleases; count *= 10) {
+    suite.push_back({"UpdateReputation/" + std::to_string(count),
+                     [&opt, count] {
+                       return ReputationBenchmark(opt, count);
+                     }});
+  }
+  for (size_t count = 100; count <= maxReleases; count *= 10) {
+    suite.push_back({"RemoveExpired/idle/" + std::to_string(count),
+                     [&opt, count] { return ExpiryBenchmark(opt, count); }});
+  }
+
+  suite.push_back({"UpdateFanbase", [&opt] { return FanbaseBenchmark(opt); }});
+  suite.push_back(
+      {"GetBaseQuality", [] { return BaseQualityBenchmark(false); }});
+  suite.push_back(
+      {"GetBaseQuality/dirty", [] { return BaseQualityBenchmark(true); }});
+  for (size_t tracks = 1; tracks <= 30; ++tracks) {
+    suite.push_back({"CalcAlbumQuality/" + std::to_string(tracks),
+                     [&opt, tracks] {
+                       return AlbumQualityBenchmark(opt, tracks);
+                     }});
+  }
+  for (size_t count = 100; count <= 10000; count *= 10) {
+    suite.push_back({"AlbumQualityModel/toggle/" + std::to_string(count),
+                     [&opt, count] { return AlbumModelBenchmark(opt, count); }});
+  }
+  for (size_t count = 100; count <= 10000; count *= 10) {
+    suite.push_back({"FindBestTracklist/" + std::to_string(count),
+                     [&opt, count] { return TracklistBenchmark(opt, count); }});
+  }
+  suite.push_back(
+      {"GenerateSongName", [&opt] { return SongNameBenchmark(opt); }});
+  return suite;
+}
+
+// --- Output ---
+
+double OpsPerSecond(const BenchResult &result) {
+  return result.nsPerOp > 0.0 ? 1e9 / result.nsPerOp : 0.0;
+}
+
+void PrintRow(const BenchResult &result) {
+  std::printf("%-34s %14.1f %14.0f %14.0f %10.2f %12.1f\n",
+              result.name.c_str(), result.nsPerOp, OpsPerSecond(result),
+              OpsPerSecond(result) * result.itemsPerOp, result.allocsPerOp,
+              result.bytesPerOp);
+  std::fflush(stdout);
+}
+
+bool WriteJson(const std::string &path, const BenchOptions &opt,
+               const std::vector<BenchResult> &results) {
+  std::FILE *out = std::fopen(path.c_str(), "w");
+  if (!out)
+    return false;
+
+  std::fprintf(out, "{\n  \"context\": {\n");
+  std::fprintf(out, "    \"simd\": \"%s\",\n", SimdLevelName(GetSimdLevel()));
+  std::fprintf(out, "    \"curves\": \"%s\",\n",
+               CurveModeName(GetCurveMode()));
+  std::fprintf(out, "    \"threads\": %zu,\n", SharedThreadPool().Size());
+  std::fprintf(out, "    \"seed\": %llu,\n",
+               static_cast<unsigned long long>(opt.seed));
+  std::fprintf(out, "    \"min_time_s\": %g,\n", opt.minTime);
+  std::fprintf(out, "    \"repeat\": %d\n  },\n", opt.repeat);
+  std::fprintf(out, "  \"benchmarks\": [\n");
+  for (size_t i = 0; i < results.size(); ++i) {
+    const BenchResult &result = results[i];
+    std::fprintf(out,
+                 "    {\"name\": \"%s\", \"iterations\": %llu, "
+                 "\"ns_per_op\": %.3f, \"ops_per_second\": %.3f, "
+                 "\"items_per_second\": %.3f, \"allocs_per_op\": %.4f, "
+                 "\"bytes_per_op\": %.2f}%s\n",
+                 result.name.c_str(),
+                 static_cast<unsigned long long>(result.iterations),
+                 result.nsPerOp, OpsPerSecond(result),
+                 OpsPerSecond(result) * result.itemsPerOp, result.allocsPerOp,
+                 result.bytesPerOp, i + 1 < results.size() ? "," : "");
+  }
+  std::fprintf(out, "  ]\n}\n");
+  return std::fclose(out) == 0;
+}
+
+bool WriteCsv(const std::string &path,
+              const std::vector<BenchResult> &results) {
+  std::FILE *out = std::fopen(path.c_str(), "w");
+  if (!out)
+    return false;
+
+  std::fprintf(out, "name,iterations,ns_per_op,ops_per_second,"
+                    "items_per_second,allocs_per_op,bytes_per_op\n");
+  for (const BenchResult &result : results) {
+    std::fprintf(out, "%s,%llu,%.3f,%.3f,%.3f,%.4f,%.2f\n",
+                 result.name.c_str(),
+                 static_cast<unsigned long long>(result.iterations),
+                 result.nsPerOp, OpsPerSecond(result),
+                 OpsPerSecond(result) * result.itemsPerOp, result.allocsPerOp,
+                 result.bytesPerOp);
+  }
+  return std::fclose(out) == 0;
+}
+
+void PrintUsage(const char *exe) {
+  std::printf(
+      "Usage: %s [options]\n"
+      "  --filter TEXT      only run benchmarks whose name contains TEXT\n"
+      "  --min-time S       seconds per timed run (default 0.2)\n"
+      "  --repeat N         timed runs per benchmark, fastest kept "
+      "(default 3)\n"
+      "  --max-releases N   largest catalog size (default 1000000)\n"
+      "  --json PATH        also write results as JSON\n"
+      "  --csv PATH         also write results as CSV\n"
+      "  --seed N           RNG seed for fixtures and inputs\n"
+      "  --simd LEVEL       scalar | sse2 | avx2 (default: best available)\n"
+      "  --curves MODE      table | exact quality curves (default table)\n",
+      exe);
+}
+
+bool ParseArgs(int argc, char **argv, BenchOptions &opt) {
+  for (int i = 1; i < argc; ++i) {
+    const char *arg = argv[i];
+    if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0)
+      return false;
+
+    // Every option takes exactly one value
+    if (i + 1 >= argc) {
+      std::fprintf(stderr, "Missing value for %s\n", arg);
+      return false;
+    }
+    const char *value = argv[++i];
+
+    if (std::strcmp(arg, "--filter") == 0)
+      opt.filter = value;
+    else if (std::strcmp(arg, "--min-time") == 0)
+      opt.minTime = std::max(0.001, std::atof(value));
+    else if (std::strcmp(arg, "--repeat") == 0)
+      opt.repeat = std::max(1, std::atoi(value));
+    else if (std::strcmp(arg, "--max-releases") == 0)
+      opt.maxReleases = std::atoll(value);
+    else if (std::strcmp(arg, "--json") == 0)
+      opt.jsonPath = value;
+    else if (std::strcmp(arg, "--csv") == 0)
+      opt.csvPath = value;
+    else if (std::strcmp(arg, "--seed") == 0)
+      opt.seed = std::strtoull(value, nullptr, 0);
+    else if (std::strcmp(arg, "--simd") == 0) {
+      if (std::strcmp(value, "scalar") == 0)
+        opt.simd = SimdLevel::Scalar;
+      else if (std::strcmp(value, "sse2") == 0)
+        opt.simd = SimdLevel::SSE2;
+      else if (std::strcmp(value, "avx2") == 0)
+        opt.simd = SimdLevel::AVX2;
+      else {
+        std::fprintf(stderr, "Unknown SIMD level: %s\n", value);
+        return false;
+      }
+    } else if (std::strcmp(arg, "--curves") == 0) {
+      if (std::strcmp(value, "table") == 0)
+        opt.curves = CurveMode::Table;
+      else if (std::strcmp(value, "exact") == 0)
+        opt.curves = CurveMode::Exact;
+      else {
+        std::fprintf(stderr, "Unknown curve mode: %s\n", value);
+        return false;
+      }
+    } else {
+      std::fprintf(stderr, "Unknown option: %s\n", arg);
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  BenchOptions opt;
+  if (!ParseArgs(argc, argv, opt)) {
+    PrintUsage(argv[0]);
+    return 1;
+  }
+
+  SetSimdLevel(opt.simd);
+  SetCurveMode(opt.curves);
+  std::printf("Kernel: %s, curves: %s, pool threads: %zu, min time %.3g s x "
+              "%d\n",
+              SimdLevelName(GetSimdLevel()), CurveModeName(GetCurveMode()),
+              SharedThreadPool().Size(), opt.minTime, opt.repeat);
+  std::printf("%-34s %14s %14s %14s %10s %12s\n", "benchmark", "ns/op",
+              "ops/s", "items/s", "allocs/op", "bytes/op");
+
+  std::vector<BenchResult> results;
+  for (const BenchEntry &entry : BuildSuite(opt)) {
+    if (!opt.filter.empty() &&
+        entry.name.find(opt.filter) == std::string::npos)
+      continue;
+
+    // The fixture dies with 'bench' before the next one is built
+    Benchmark bench = entry.make();
+    results.push_back(Measure(bench, opt));
+    PrintRow(results.back());
+  }
+
+  if (!opt.jsonPath.empty() && !WriteJson(opt.jsonPath, opt, results)) {
+    std::fprintf(stderr, "Could not write %s\n", opt.jsonPath.c_str());
+    return 1;
+  }
+  if (!opt.csvPath.empty() && !WriteCsv(opt.csvPath, results)) {
+    std::fprintf(stderr, "Could not write %s\n", opt.csvPath.c_str());
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,406 @@
+#include "../headers/catalog.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// O(1) unordered removal of element i from one column.
+template <typename T> void SwapPopColumn(std::vector<T> &column, size_t i) {
+  if (i + 1 != column.size())
+    column[i] = std::move(column.back());
+  column.pop_back();
+}
+
+} // namespace
+
+void ReleaseCatalog::Reserve(size_t count) {
+  id.reserve(count);
+  quality.reserve(count);
+  hype.reserve(count);
+  price.reserve(count);
+  lifeTime.reserve(count);
+  genre.reserve(count);
+  decayTime.reserve(count);
+  qualityPower.reserve(count);
+  demand.reserve(count);
+  salesChance.reserve(count);
+  dailyStreams.reserve(count);
+  totalStreams.reserve(count);
+  totalSales.reserve(count);
+  earnings.reserve(count);
+  info.reserve(count);
+  expiryHeap.reserve(count);
+  heapSlot.reserve(count);
+  ageOrder.reserve(count);
+  ageSlot.reserve(count);
+}
+
+void ReleaseCatalog::Clear() {
+  id.clear();
+  quality.clear();
+  hype.clear();
+  price.clear();
+  lifeTime.clear();
+  genre.clear();
+  decayTime.clear();
+  qualityPower.clear();
+  demand.clear();
+  salesChance.clear();
+  dailyStreams.clear();
+  totalStreams.clear();
+  totalSales.clear();
+  earnings.clear();
+  info.clear();
+  trackStore.Clear();
+  expiryHeap.clear();
+  heapSlot.clear();
+  ageOrder.clear();
+  ageSlot.clear();
+  ageHead = 0;
+  activeCount = 0;
+  qualitySum = 0.0;
+}
+
+void ReleaseCatalog::PushHot(double q, double h, double p, float life,
+                             Genre g) {
+  id.push_back(nextId++);
+  quality.push_back(q);
+  qualitySum += q;
+  hype.push_back(h);
+  price.push_back(p);
+  lifeTime.push_back(life);
+  genre.push_back(g);
+  decayTime.push_back(0.0);
+  qualityPower.push_back(0.0);
+  demand.push_back(0.0);
+  salesChance.push_back(0.0);
+  ComputeInvariants(id.size() - 1);
+  dailyStreams.push_back(0);
+  totalStreams.push_back(0);
+  totalSales.push_back(0);
+  earnings.push_back(0.0);
+
+  // New releases are usually the youngest, so this rarely sifts at all
+  uint32_t index = static_cast<uint32_t>(id.size() - 1);
+  heapSlot.push_back(static_cast<uint32_t>(expiryHeap.size()));
+  expiryHeap.push_back(index);
+  SiftUp(expiryHeap.size() - 1);
+  InsertByAge(index);
+}
+
+void ReleaseCatalog::ComputeInvariants(size_t i) {
+  PerformanceCurve curve =
+      EvaluatePerformanceCurve(quality[i], price[i], isAlbum, curves);
+  decayTime[i] = curve.decayTime;
+  qualityPower[i] = curve.qualityPower;
+  demand[i] = curve.demand;
+  salesChance[i] = curve.salesChance;
+}
+
+void ReleaseCatalog::PlaceNew() {
+  // Live releases join the end of the active range
+  size_t index = Size() - 1;
+  if (hype[index] > DEAD_HYPE) {
+    SwapReleases(index, activeCount);
+    ++activeCount;
+  }
+}
+
+void ReleaseCatalog::Add(const Song &song) {
+  PushHot(song.quality, song.hype, song.price, song.lifeTime, song.genre);
+
+  // Carry over any stats the song already has (e.g. re-released copies)
+  dailyStreams.back() = song.dailyStreams;
+  totalStreams.back() = song.totalStreams;
+  totalSales.back() = song.totalSales;
+  earnings.back() = song.earnings;
+
+  info.push_back({song.name, song.artist, {}, song.fansAtRelease});
+  PlaceNew();
+}
+
+void ReleaseCatalog::Add(const Album &album) {
+  PushHot(album.quality, album.hype, album.price, album.lifeTime,
+          album.genre);
+
+  dailyStreams.back() = album.dailyStreams;
+  totalStreams.back() = album.totalStreams;
+  totalSales.back() = album.totalSales;
+  earnings.back() = album.earnings;
+
+  ReleaseInfo &entry = info.emplace_back();
+  entry.name = album.name;
+  entry.artist = album.artist;
+  entry.tracks.reserve(album.tracks.size());
+  for (const Song &track : album.tracks)
+    entry.tracks.push_back(trackStore.Add(track));
+  PlaceNew();
+}
+
+size_t ReleaseCatalog::RemoveExpired(float maxLifeTime) {
+  size_t removed = 0;
+  while (!expiryHeap.empty() && lifeTime[expiryHeap.front()] >= maxLifeTime) {
+    size_t due = expiryHeap.front();
+
+    // 1. Into the dormant range first, so the partition holds (it stays on
+    // top of the schedule, only its index changes)
+    if (due < activeCount) {
+      SwapReleases(due, activeCount - 1);
+      due = --activeCount;
+    }
+
+    // 2. Drop it from the schedule and the old end of the age order. The
+    // oldest release there has the same lifeTime as 'due' (both are the
+    // maximum), so trading places keeps the order sorted.
+    SetHeap(0, expiryHeap.back());
+    expiryHeap.pop_back();
+    if (!expiryHeap.empty())
+      SiftDown(0);
+    uint32_t oldest = ageOrder[ageHead];
+    uint32_t dueSlot = ageSlot[due];
+    SetAge(ageHead, static_cast<uint32_t>(due));
+    SetAge(dueSlot, oldest);
+    ++ageHead;
+
+    // 3. Drop it from the columns (and its tracks from the store)
+    for (SongId track : info[due].tracks)
+      trackStore.Remove(track);
+    qualitySum -= quality[due];
+    SwapAndPop(due);
+    ++removed;
+  }
+
+  if (ageHead * 2 >= ageOrder.size())
+    CompactAgeOrder();
+
+  // Rounding leftovers must not outlive the catalog
+  if (Empty())
+    qualitySum = 0.0;
+  return removed;
+}
+
+void ReleaseCatalog::Demote(size_t i) {
+  dailyStreams[i] = 0;
+  SwapReleases(i, activeCount - 1);
+  --activeCount;
+}
+
+size_t ReleaseCatalog::DemoteDead() {
+  // Backwards, so whatever moves into slot i was already checked
+  size_t demoted = 0;
+  for (size_t i = activeCount; i-- > 0;) {
+    if (hype[i] <= DEAD_HYPE) {
+      Demote(i);
+      ++demoted;
+    }
+  }
+  return demoted;
+}
+
+void ReleaseCatalog::Reprice(size_t i, double newPrice) {
+  price[i] = newPrice;
+  ComputeInvariants(i);
+}
+
+void ReleaseCatalog::SetCurveMode(CurveMode mode) {
+  if (mode == curves)
+    return;
+  curves = mode;
+  for (size_t i = 0; i < Size(); ++i)
+    ComputeInvariants(i);
+}
+
+void ReleaseCatalog::RebuildIndex() {
+  const size_t count = Size();
+
+  // 0. Invariants
+  decayTime.resize(count);
+  qualityPower.resize(count);
+  demand.resize(count);
+  salesChance.resize(count);
+  for (size_t i = 0; i < count; ++i)
+    ComputeInvariants(i);
+
+  // 1. Partition (SwapReleases keeps heap and age slots in step, so seed
+  // them)
+  expiryHeap.resize(count);
+  heapSlot.resize(count);
+  ageOrder.resize(count);
+  ageSlot.resize(count);
+  ageHead = 0;
+  for (size_t i = 0; i < count; ++i) {
+    SetHeap(i, static_cast<uint32_t>(i));
+    SetAge(i, static_cast<uint32_t>(i));
+  }
+
+  activeCount = 0;
+  for (size_t i = 0; i < count; ++i) {
+    if (hype[i] > DEAD_HYPE)
+      SwapReleases(i, activeCount++);
+  }
+
+  // 2. Expiry schedule
+  for (size_t i = 0; i < count; ++i)
+    SetHeap(i, static_cast<uint32_t>(i));
+  for (size_t pos = count / 2; pos-- > 0;)
+    SiftDown(pos);
+
+  // 3. Age order (ties: lower id = released first)
+  for (size_t i = 0; i < count; ++i)
+    ageOrder[i] = static_cast<uint32_t>(i);
+  std::sort(ageOrder.begin(), ageOrder.end(), [this](uint32_t a, uint32_t b) {
+    if (lifeTime[a] != lifeTime[b])
+      return lifeTime[a] > lifeTime[b];
+    return id[a] < id[b];
+  });
+  for (size_t pos = 0; pos < count; ++pos)
+    ageSlot[ageOrder[pos]] = static_cast<uint32_t>(pos);
+
+  // 4. Reputation aggregate
+  qualitySum = SumQuality();
+}
+
+double ReleaseCatalog::SumQuality() const {
+  double sum = 0.0;
+  for (double q : quality)
+    sum += q;
+  return sum;
+}
+
+void ReleaseCatalog::SwapReleases(size_t a, size_t b) {
+  if (a == b)
+    return;
+
+  std::swap(id[a], id[b]);
+  std::swap(quality[a], quality[b]);
+  std::swap(hype[a], hype[b]);
+  std::swap(price[a], price[b]);
+  std::swap(lifeTime[a], lifeTime[b]);
+  std::swap(genre[a], genre[b]);
+  std::swap(decayTime[a], decayTime[b]);
+  std::swap(qualityPower[a], qualityPower[b]);
+  std::swap(demand[a], demand[b]);
+  std::swap(salesChance[a], salesChance[b]);
+  std::swap(dailyStreams[a], dailyStreams[b]);
+  std::swap(totalStreams[a], totalStreams[b]);
+  std::swap(totalSales[a], totalSales[b]);
+  std::swap(earnings[a], earnings[b]);
+  std::swap(info[a], info[b]);
+
+  // Each keeps its heap position; only the stored indices follow
+  uint32_t slotA = heapSlot[a];
+  uint32_t slotB = heapSlot[b];
+  SetHeap(slotA, static_cast<uint32_t>(b));
+  SetHeap(slotB, static_cast<uint32_t>(a));
+  uint32_t ageA = ageSlot[a];
+  uint32_t ageB = ageSlot[b];
+  SetAge(ageA, static_cast<uint32_t>(b));
+  SetAge(ageB, static_cast<uint32_t>(a));
+}
+
+void ReleaseCatalog::SwapAndPop(size_t i) {
+  const size_t last = Size() - 1;
+
+  // The release moving into slot i keeps its place in the schedule (its
+  // lifeTime moves with it); only the index stored there changes
+  if (i != last) {
+    SetHeap(heapSlot[last], static_cast<uint32_t>(i));
+    SetAge(ageSlot[last], static_cast<uint32_t>(i));
+  }
+
+  SwapPopColumn(id, i);
+  SwapPopColumn(quality, i);
+  SwapPopColumn(hype, i);
+  SwapPopColumn(price, i);
+  SwapPopColumn(lifeTime, i);
+  SwapPopColumn(genre, i);
+  SwapPopColumn(decayTime, i);
+  SwapPopColumn(qualityPower, i);
+  SwapPopColumn(demand, i);
+  SwapPopColumn(salesChance, i);
+  SwapPopColumn(dailyStreams, i);
+  SwapPopColumn(totalStreams, i);
+  SwapPopColumn(totalSales, i);
+  SwapPopColumn(earnings, i);
+  SwapPopColumn(info, i);
+  heapSlot.pop_back();
+  ageSlot.pop_back();
+}
+
+// ----------------------------------------------------------------------------
+// EXPIRY HEAP
+// ----------------------------------------------------------------------------
+
+bool ReleaseCatalog::ExpiresBefore(uint32_t a, uint32_t b) const {
+  // lifeTime only: adding the same dt can turn a > b into a tie but never
+  // into a < b, so no other tie-break would stay valid as releases age
+  return lifeTime[a] > lifeTime[b];
+}
+
+void ReleaseCatalog::SetHeap(size_t pos, uint32_t index) {
+  expiryHeap[pos] = index;
+  heapSlot[index] = static_cast<uint32_t>(pos);
+}
+
+void ReleaseCatalog::SiftUp(size_t pos) {
+  uint32_t index = expiryHeap[pos];
+  while (pos > 0) {
+    size_t parent = (pos - 1) / 2;
+    if (!ExpiresBefore(index, expiryHeap[parent]))
+      break;
+    SetHeap(pos, expiryHeap[parent]);
+    pos = parent;
+  }
+  SetHeap(pos, index);
+}
+
+void ReleaseCatalog::SiftDown(size_t pos) {
+  const size_t count = expiryHeap.size();
+  uint32_t index = expiryHeap[pos];
+  while (true) {
+    size_t child = pos * 2 + 1;
+    if (child >= count)
+      break;
+    if (child + 1 < count &&
+        ExpiresBefore(expiryHeap[child + 1], expiryHeap[child]))
+      ++child;
+    if (!ExpiresBefore(expiryHeap[child], index))
+      break;
+    SetHeap(pos, expiryHeap[child]);
+    pos = child;
+  }
+  SetHeap(pos, index);
+}
+
+// ----------------------------------------------------------------------------
+// AGE ORDER
+// ----------------------------------------------------------------------------
+
+void ReleaseCatalog::SetAge(size_t pos, uint32_t index) {
+  ageOrder[pos] = index;
+  ageSlot[index] = static_cast<uint32_t>(pos);
+}
+
+void ReleaseCatalog::InsertByAge(uint32_t index) {
+  // New releases are the youngest (lifeTime 0), so this almost always
+  // appends; an older one (re-released copy) shifts the younger ones up
+  size_t pos = ageOrder.size();
+  while (pos > ageHead && lifeTime[ageOrder[pos - 1]] < lifeTime[index])
+    --pos;
+  ageSlot.push_back(0);
+  ageOrder.insert(ageOrder.begin() + static_cast<std::ptrdiff_t>(pos), index);
+  for (size_t p = pos; p < ageOrder.size(); ++p)
+    ageSlot[ageOrder[p]] = static_cast<uint32_t>(p);
+}
+
+void ReleaseCatalog::CompactAgeOrder() {
+  // Amortized O(1) per expiry: at least as many expiries as moves
+  ageOrder.erase(ageOrder.begin(),
+                 ageOrder.begin() + static_cast<std::ptrdiff_t>(ageHead));
+  ageHead = 0;
+  for (size_t pos = 0; pos < ageOrder.size(); ++pos)
+    ageSlot[ageOrder[pos]] = static_cast<uint32_t>(pos);
+}
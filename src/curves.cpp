@@ -0,0 +1,161 @@
+#include "../headers/curves.h"
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// COMPILE-TIME MATH
+// ----------------------------------------------------------------------------
+// std::exp / std::log are not constexpr; these are accurate to a few ulp,
+// far below CURVE_TABLE_TOLERANCE, over the ranges the tables use.
+
+constexpr double LN2 = 0.693147180559945309417232121458;
+
+constexpr double ConstExp(double x) {
+  // x = k ln2 + r, |r| <= ln2 / 2; Taylor series for e^r
+  int k = static_cast<int>(x / LN2 + (x < 0.0 ? -0.5 : 0.5));
+  double r = x - k * LN2;
+  double term = 1.0;
+  double sum = 1.0;
+  for (int i = 1; i < 24; ++i) {
+    term *= r / i;
+    sum += term;
+  }
+  for (; k > 0; --k)
+    sum *= 2.0;
+  for (; k < 0; ++k)
+    sum *= 0.5;
+  return sum;
+}
+
+constexpr double ConstLog(double x) {
+  // x = m 2^e, m in [sqrt(1/2), sqrt(2)); log m = 2 atanh((m - 1) / (m + 1))
+  int e = 0;
+  while (x >= 1.4142135623730951) {
+    x *= 0.5;
+    ++e;
+  }
+  while (x < 0.7071067811865476) {
+    x *= 2.0;
+    --e;
+  }
+  double z = (x - 1.0) / (x + 1.0);
+  double z2 = z * z;
+  double power = z;
+  double sum = 0.0;
+  for (int i = 1; i < 40; i += 2) {
+    sum += power / i;
+    power *= z2;
+  }
+  return 2.0 * sum + e * LN2;
+}
+
+constexpr double ConstPow(double x, double y) {
+  return x > 0.0 ? ConstExp(y * ConstLog(x)) : 0.0;
+}
+
+// ----------------------------------------------------------------------------
+// TABLES
+// ----------------------------------------------------------------------------
+
+// The exact curves and their derivatives, as curves.h evaluates them.
+constexpr double Discovery(double q) {
+  return ConstPow(q / EconomyConfig::DISCOVERY_QUALITY_SCALE,
+                  EconomyConfig::DISCOVERY_EXPONENT);
+}
+constexpr double DiscoverySlope(double q) {
+  return EconomyConfig::DISCOVERY_EXPONENT /
+         EconomyConfig::DISCOVERY_QUALITY_SCALE *
+         ConstPow(q / EconomyConfig::DISCOVERY_QUALITY_SCALE,
+                  EconomyConfig::DISCOVERY_EXPONENT - 1.0);
+}
+
+constexpr double CONVERSION_SPAN =
+    EconomyConfig::MAX_QUALITY - EconomyConfig::CONVERSION_MIN_QUALITY;
+
+constexpr double Conversion(double q) {
+  return EconomyConfig::CONVERSION_BASE +
+         ConstPow((q - EconomyConfig::CONVERSION_MIN_QUALITY) / CONVERSION_SPAN,
+                  EconomyConfig::CONVERSION_EXPONENT) *
+             EconomyConfig::CONVERSION_RANGE;
+}
+constexpr double ConversionSlope(double q) {
+  return EconomyConfig::CONVERSION_RANGE * EconomyConfig::CONVERSION_EXPONENT /
+         CONVERSION_SPAN *
+         ConstPow((q - EconomyConfig::CONVERSION_MIN_QUALITY) / CONVERSION_SPAN,
+                  EconomyConfig::CONVERSION_EXPONENT - 1.0);
+}
+
+constexpr double Freshness(double age) { return ConstExp(-age); }
+constexpr double FreshnessSlope(double age) { return -ConstExp(-age); }
+
+template <size_t Knots, typename F, typename DF>
+constexpr CurveTable<Knots> MakeCurveTable(double lo, double knotsPerUnit,
+                                           F f, DF df) {
+  CurveTable<Knots> table;
+  const double step = 1.0 / knotsPerUnit;
+  table.lo = lo;
+  table.hi = lo + static_cast<double>(Knots - 1) * step;
+  table.invStep = knotsPerUnit;
+  for (size_t i = 0; i < Knots; ++i) {
+    double x = lo + static_cast<double>(i) * step;
+    table.knots[i].value = f(x);
+    table.knots[i].slope = df(x) * step;
+  }
+  return table;
+}
+
+// Precision guarantee: the interpolation error peaks inside an interval,
+// so compare a quarter, half and three quarters of the way across each.
+template <size_t Knots, typename F>
+constexpr bool WithinTolerance(const CurveTable<Knots> &table, F f) {
+  const double step = 1.0 / table.invStep;
+  for (size_t i = 0; i + 1 < Knots; ++i) {
+    for (double s : {0.25, 0.5, 0.75}) {
+      double x = table.lo + (static_cast<double>(i) + s) * step;
+      double exact = f(x);
+      double error = table(x) - exact;
+      if (error < 0.0)
+        error = -error;
+      if (error > CURVE_TABLE_TOLERANCE * (exact < 0.0 ? -exact : exact))
+        return false;
+    }
+  }
+  return true;
+}
+
+constexpr CurveTable<DISCOVERY_KNOTS> DISCOVERY = MakeCurveTable<DISCOVERY_KNOTS>(
+    EconomyConfig::MIN_QUALITY, QUALITY_KNOTS_PER_POINT, Discovery,
+    DiscoverySlope);
+constexpr CurveTable<CONVERSION_KNOTS> CONVERSION =
+    MakeCurveTable<CONVERSION_KNOTS>(EconomyConfig::CONVERSION_MIN_QUALITY,
+                                     QUALITY_KNOTS_PER_POINT, Conversion,
+                                     ConversionSlope);
+constexpr CurveTable<FRESHNESS_KNOTS> FRESHNESS = MakeCurveTable<FRESHNESS_KNOTS>(
+    0.0, AGE_KNOTS_PER_UNIT, Freshness, FreshnessSlope);
+
+static_assert(DISCOVERY.hi == EconomyConfig::MAX_QUALITY);
+static_assert(CONVERSION.hi == EconomyConfig::MAX_QUALITY);
+static_assert(FRESHNESS.hi == FRESHNESS_MAX_AGE);
+
+static_assert(WithinTolerance(DISCOVERY, Discovery),
+              "Discovery table misses CURVE_TABLE_TOLERANCE");
+static_assert(WithinTolerance(CONVERSION, Conversion),
+              "Conversion table misses CURVE_TABLE_TOLERANCE");
+static_assert(WithinTolerance(FRESHNESS, Freshness),
+              "Freshness table misses CURVE_TABLE_TOLERANCE");
+
+CurveMode activeMode = CurveMode::Table;
+
+} // namespace
+
+const CurveTable<DISCOVERY_KNOTS> DISCOVERY_TABLE = DISCOVERY;
+const CurveTable<CONVERSION_KNOTS> CONVERSION_TABLE = CONVERSION;
+const CurveTable<FRESHNESS_KNOTS> FRESHNESS_TABLE = FRESHNESS;
+
+CurveMode GetCurveMode() { return activeMode; }
+
+void SetCurveMode(CurveMode mode) { activeMode = mode; }
+
+const char *CurveModeName(CurveMode mode) {
+  return mode == CurveMode::Table ? "Table" : "Exact";
+}
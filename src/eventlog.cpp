@@ -0,0 +1,193 @@
+#include "../headers/eventlog.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+EventLog gameLog;
+
+namespace {
+
+constexpr uint64_t BUSY = 1; // Stamp bit: a writer is copying into the slot
+
+// Stamp of a finished write of 'ticket' (0 = never written)
+constexpr uint64_t Stamp(uint64_t ticket) { return (ticket + 1) << 1; }
+
+} // namespace
+
+// ----------------------------------------------------------------------------
+// FORMATTING (only when a line is shown)
+// ----------------------------------------------------------------------------
+
+void LogEntry::Format(char *buffer, size_t size) const {
+  if (size == 0)
+    return;
+
+  const char *genreName = GenreName(genre).data();
+  switch (id) {
+  case LogMessage::EngineInitialized:
+    std::snprintf(buffer, size, "Engine Initialized. Seed: %" PRIu64,
+                  static_cast<uint64_t>(number));
+    break;
+  case LogMessage::Viral:
+    std::snprintf(buffer, size, "VIRAL SENSATION! %" PRId64 " new fans!",
+                  number);
+    break;
+  case LogMessage::Scandal:
+    std::snprintf(buffer, size,
+                  "SCANDAL: Bad press caused %" PRId64 " fans to leave!",
+                  number);
+    break;
+  case LogMessage::MarketShift:
+    std::snprintf(buffer, size, "Market Shift! Trending: %s (+%.2fx bonus)",
+                  genreName, value);
+    break;
+  case LogMessage::Recorded:
+    std::snprintf(buffer, size, "Recorded: %s [%s] (Q: %" PRId64 ")", text,
+                  genreName, number);
+    break;
+  case LogMessage::NoEnergyToRecord:
+    std::snprintf(buffer, size, "Not enough energy to record song.");
+    break;
+  case LogMessage::ReleasedSingle:
+    std::snprintf(buffer, size, "Released Single: %s", text);
+    break;
+  case LogMessage::ReleasedEP:
+    std::snprintf(buffer, size, "Released EP: %s", text);
+    break;
+  case LogMessage::ReleasedLP:
+    std::snprintf(buffer, size, "Released LP: %s", text);
+    break;
+  case LogMessage::NoEnergyToRelease:
+    std::snprintf(buffer, size, "Not enough energy to release album.");
+    break;
+  case LogMessage::Learned:
+    std::snprintf(buffer, size, "Learned %s", text);
+    break;
+  case LogMessage::Upgraded:
+    std::snprintf(buffer, size, "Upgraded");
+    break;
+  case LogMessage::BuskTooShort:
+    std::snprintf(buffer, size,
+                  "Please use game slider to set time busking (min 30 "
+                  "mins).");
+    break;
+  case LogMessage::Busked:
+    std::snprintf(buffer, size, "Busked for %.2f minutes.", value);
+    break;
+  case LogMessage::NoEnergyToBusk:
+    std::snprintf(buffer, size, "Not enough energy to busk for %.0f mins!",
+                  value);
+    break;
+  case LogMessage::VaultChanged:
+    std::snprintf(buffer, size, "Vault changed, release skipped.");
+    break;
+  case LogMessage::GameSaved:
+    std::snprintf(buffer, size, "Game saved.");
+    break;
+  case LogMessage::SaveFailed:
+    std::snprintf(buffer, size, "Save failed: %s", text);
+    break;
+  case LogMessage::LoadedCareer:
+    std::snprintf(buffer, size, "Loaded career of %s", text);
+    break;
+  case LogMessage::LoadFailed:
+    std::snprintf(buffer, size, "Load failed: %s", text);
+    break;
+  case LogMessage::SkippedDays:
+    std::snprintf(buffer, size, "Skipped %" PRId64 " days.", number);
+    break;
+  case LogMessage::RecordingFailed:
+    std::snprintf(buffer, size, "Session not recorded: %s", text);
+    break;
+  default:
+    buffer[0] = '\0';
+    break;
+  }
+}
+
+// ----------------------------------------------------------------------------
+// RING
+// ----------------------------------------------------------------------------
+
+EventLog &EventLog::operator=(const EventLog &other) {
+  if (this == &other)
+    return *this;
+
+  for (size_t i = 0; i < CAPACITY; ++i) {
+    slots[i].stamp.store(other.slots[i].stamp.load(std::memory_order_acquire),
+                         std::memory_order_relaxed);
+    slots[i].entry = other.slots[i].entry;
+  }
+  head.store(other.head.load(std::memory_order_acquire),
+             std::memory_order_release);
+  return *this;
+}
+
+void EventLog::Add(LogMessage id, const LogArgs &args) {
+  // 1. Take a ticket: it alone decides the slot and the line's position
+  const uint64_t ticket = head.fetch_add(1, std::memory_order_relaxed);
+  Slot &slot = slots[ticket % CAPACITY];
+
+  // 2. Claim the slot. If another writer still copies into it, or a newer
+  // ticket already landed there (the ring wrapped mid-burst), this line is
+  // dropped rather than waited for.
+  uint64_t seen = slot.stamp.load(std::memory_order_relaxed);
+  do {
+    if ((seen & BUSY) || seen > Stamp(ticket))
+      return;
+  } while (!slot.stamp.compare_exchange_weak(seen, Stamp(ticket) | BUSY,
+                                             std::memory_order_acquire,
+                                             std::memory_order_relaxed));
+
+  // 3. Copy the arguments (no formatting, no allocation)
+  LogEntry &entry = slot.entry;
+  entry.id = id;
+  entry.genre = args.genre;
+  entry.number = args.number;
+  entry.value = args.value;
+  size_t length = std::min(args.text.size(), LogEntry::TEXT_SIZE - 1);
+  if (length > 0)
+    std::memcpy(entry.text, args.text.data(), length);
+  entry.text[length] = '\0';
+
+  // 4. Publish
+  slot.stamp.store(Stamp(ticket), std::memory_order_release);
+}
+
+size_t EventLog::Size() const {
+  uint64_t count = head.load(std::memory_order_acquire);
+  return static_cast<size_t>(std::min<uint64_t>(count, CAPACITY));
+}
+
+bool EventLog::Get(size_t age, LogEntry &entry) const {
+  uint64_t count = head.load(std::memory_order_acquire);
+  if (age >= std::min<uint64_t>(count, CAPACITY))
+    return false;
+
+  uint64_t ticket = count - 1 - age;
+  const Slot &slot = slots[ticket % CAPACITY];
+  if (slot.stamp.load(std::memory_order_acquire) != Stamp(ticket))
+    return false;
+
+  entry = slot.entry;
+  return true;
+}
+
+std::string EventLog::Text(size_t age) const {
+  LogEntry entry;
+  if (!Get(age, entry))
+    return {};
+
+  char buffer[256];
+  entry.Format(buffer, sizeof(buffer));
+  return buffer;
+}
+
+void EventLog::Clear() {
+  for (Slot &slot : slots)
+    slot.stamp.store(0, std::memory_order_relaxed);
+  head.store(0, std::memory_order_release);
+}
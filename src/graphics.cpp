@@ -1,27 +1,31 @@
 #include "../headers/graphics.h"
+#include "../headers/albumquality.h"
 #include "../headers/helper.h"
-#include "../headers/simulation.h"
+#include "../headers/Simulation.h"
+#include "../headers/savegame.h"
+#include "../headers/stringpool.h"
+#include "../headers/tracklist.h"
 #include "imgui.h"
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstdio>
+#include <iterator>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
-EventLog gameLog;
-
-void EventLog::Add(const std::string &message) {
-  logs.push_front(message);
-  if (logs.size() > 50)
-    logs.pop_back();
-}
-
-void EventLog::DrawWindow([[maybe_unused]] sf::Time dt,
-                          std::shared_ptr<float> tickTimer) {
+void EventLog::DrawWindow([[maybe_unused]] float dt,
+                          const MarketState &market) const {
   // Note: 'dt' is marked [[maybe_unused]] to prevent compiler warnings
   // since the simulation logic handles the time accumulation elsewhere.
 
   if (ImGui::Begin("News Feed")) {
-    // 1. Get Market Data (Uses C++20 structured binding)
-    auto [trendMultiplier, trendingGenre] = GetMarketTrend(tickTimer);
+    // 1. Get Market Data (read only; the economy tick moves the market)
+    float trendMultiplier = market.multiplier;
+    std::string_view trendName = GenreName(market.genre);
 
     // 2. Header Section
     // Use TextColored for the alert label
@@ -31,8 +35,8 @@ void EventLog::DrawWindow([[maybe_unused]] sf::Time dt,
 
     // FIX: string_view does not have .c_str().
     // Use "%.*s" with size and data to print string_view safely in ImGui.
-    ImGui::Text("Current Trend: %.*s", static_cast<int>(trendingGenre.size()),
-                trendingGenre.data());
+    ImGui::Text("Current Trend: %.*s", static_cast<int>(trendName.size()),
+                trendName.data());
 
     ImGui::Text("Impact Multiplier: %.2fx", trendMultiplier);
     ImGui::Separator();
@@ -42,9 +46,14 @@ void EventLog::DrawWindow([[maybe_unused]] sf::Time dt,
     // FIX: Pass true (or ImGuiChildFlags_Border) to visualize the logging area.
     if (ImGui::BeginChild("LogScroll", ImVec2(0.0f, 0.0f), true)) {
 
-      // Iterate continuously through logs
-      for (const auto &log : logs) {
-        ImGui::TextWrapped("%s", log.c_str());
+      // Newest first; lines are formatted here, only when shown
+      LogEntry entry;
+      char line[256];
+      for (size_t age = 0; age < Size(); ++age) {
+        if (!Get(age, entry))
+          continue;
+        entry.Format(line, sizeof(line));
+        ImGui::TextWrapped("%s", line);
         ImGui::Separator();
       }
 
@@ -59,40 +68,46 @@ void EventLog::DrawWindow([[maybe_unused]] sf::Time dt,
   ImGui::End();
 }
 
-std::string BeginDropDownMenu(bool IsOpen) {
-  static int selected_idx = 0;
-  const char *items[] = {"Pop",       "Rock",  "Hip-Hop",     "R&B",     "Jazz",
-                         "Classical", "Other", "Electronic",  "Country", "Folk",
-                         "Metal",     "Indie", "Experimental"};
-
-  // 1. Use 'if' instead of 'while' to prevent the app from freezing.
-  if (IsOpen) {
-    // 2. Only call EndCombo() if BeginCombo() returns true.
-    if (ImGui::BeginCombo("Genre", items[selected_idx])) {
-      for (int n = 0; n < (int)IM_ARRAYSIZE(items); n++) {
-        const bool is_selected = (selected_idx == n);
-
-        if (ImGui::Selectable(items[n], is_selected)) {
-          selected_idx = n;
-        }
+// Combo over every recordable genre. Names come from the registry; the
+// selection is kept as an id. Returns true if the selection changed.
+static bool GenreCombo(const char *label, Genre &selected) {
+  bool changed = false;
+  if (ImGui::BeginCombo(label, GenreName(selected).data())) {
+    for (size_t n = 0; n < GENRE_COUNT; n++) {
+      const bool is_selected = (GenreIndex(selected) == n);
+
+      if (ImGui::Selectable(GENRE_NAMES[n].data(), is_selected)) {
+        selected = GenreAt(n);
+        changed = true;
+      }
 
-        if (is_selected) {
-          ImGui::SetItemDefaultFocus();
-        }
+      if (is_selected) {
+        ImGui::SetItemDefaultFocus();
       }
-      // Move EndCombo inside the successful BeginCombo block
-      ImGui::EndCombo();
     }
+    ImGui::EndCombo();
+  }
+  return changed;
+}
+
+Genre BeginDropDownMenu(bool IsOpen) {
+  static Genre selected = Genre::Pop;
+
+  // 1. Use 'if' instead of 'while' to prevent the app from freezing.
+  if (IsOpen) {
+    // 2. Only call EndCombo() if BeginCombo() returns true (see GenreCombo).
+    GenreCombo("Genre", selected);
   }
 
   // 3. Always return the current selection, whether the menu was drawn this
   // frame or not.
-  return items[selected_idx];
+  return selected;
 }
 
-void DrawStudioWindow(Player &player, std::vector<Song> &songsMade,
-                      std::vector<Song> &songsReleased,
-                      std::vector<Album> &albumsReleased) {
+void DrawStudioWindow(const WorldSnapshot &view, SimulationThread &sim) {
+  const Player &player = view.player;
+  const SlotMap<Song> &songsMade = view.vault;
+
   ImGui::Begin("Production Studio");
 
   // --- 1. Header & Stats ---
@@ -118,55 +133,79 @@ void DrawStudioWindow(Player &player, std::vector<Song> &songsMade,
   ImGui::InputText("##songname", nameBuffer, IM_ARRAYSIZE(nameBuffer));
   ImGui::SameLine();
   if (ImGui::Button("Rnd Name")) {
-    strcpy_s(nameBuffer, GenerateSongName().c_str());
+    std::snprintf(nameBuffer, sizeof(nameBuffer), "%s",
+                  GenerateSongName().c_str());
   }
 
   // Genre Selection
-  static std::string currentGenre = "Pop";
-  if (ImGui::BeginCombo("Genre", currentGenre.c_str())) {
-    std::vector<std::string> genres = {"Pop",  "Rock",      "Hip-Hop", "R&B",
-                                       "Jazz", "Classical", "Other"};
-    for (const auto &g : genres) {
-      bool isSelected = (currentGenre == g);
-      if (ImGui::Selectable(g.c_str(), isSelected)) {
-        currentGenre = g;
-      }
-      if (isSelected)
-        ImGui::SetItemDefaultFocus();
-    }
-    ImGui::EndCombo();
-  }
+  static Genre currentGenre = Genre::Pop;
+  GenreCombo("Genre", currentGenre);
 
   // Quality Preview
   double uiEstimate = player.GetBaseQuality();
   ImGui::TextColored(ImVec4(1, 1, 0, 1), "Est. Quality: %.1f (Skill based)",
                      uiEstimate);
 
+  // Energy is checked (and the quality rolled) on the simulation thread
   if (ImGui::Button("Record Song",
                     ImVec2(ImGui::GetContentRegionAvail().x, 30))) {
-    double recordedQuality = player.CalcQuality();
-    if (player.Energy >= 5.0) {
-
-      player.Energy -= 5.0;
-
-      songsMade.emplace_back(std::string(nameBuffer), player.name, currentGenre,
-                             recordedQuality, player.fans,
-                             GetRecommendedPrice(recordedQuality, false));
-
-      gameLog.Add("Recorded: " + std::string(nameBuffer) + " [" + currentGenre +
-                  "] (Q: " + std::to_string((int)recordedQuality) + ")");
-    } else {
-      gameLog.Add("Not enough energy to record song.");
-    }
+    SimCommand command;
+    command.kind = SimCommandKind::RecordSong;
+    command.text = nameBuffer;
+    command.genre = currentGenre;
+    sim.Post(std::move(command));
   }
 
   ImGui::Separator();
 
-  // --- 3. Selection Synchronization ---
-  // Ensure the checkbox vector matches the number of songs
-  static std::vector<bool> selectedSongs;
-  if (selectedSongs.size() != songsMade.size()) {
-    selectedSongs.resize(songsMade.size(), false);
+  // --- 3. Selection ---
+  // Keyed by handle: slot index -> selected generation + 1 (0 = not
+  // selected). A released or reloaded song's handle goes stale, so its
+  // selection simply stops matching; nothing has to be kept in sync.
+  static std::vector<uint32_t> selected;
+  auto IsSelected = [&](SlotHandle song) {
+    return song.index < selected.size() &&
+           selected[song.index] == song.generation + 1;
+  };
+  auto SetSelected = [&](SlotHandle song, bool on) {
+    if (song.index >= selected.size())
+      selected.resize(song.index + 1, 0);
+    selected[song.index] = on ? song.generation + 1 : 0;
+  };
+
+  // Album estimate for the selection: one O(log n) update per checkbox
+  // instead of re-gathering and re-sorting the selection every frame. The
+  // model's candidates are the vault's dense positions, so it is rebuilt
+  // whenever the vault changes (new take, release, load).
+  static AlbumQualityModel albumModel;
+  static std::array<int, GENRE_COUNT> genreCounts{};
+  static uint64_t modelRevision = UINT64_MAX;
+  auto Select = [&](size_t i, bool on) {
+    SetSelected(songsMade.HandleAt(i), on);
+    if (albumModel.IsSelected(i) == on)
+      return;
+    albumModel.Select(i, on);
+    Genre genre = songsMade.At(i).genre;
+    if (genre != Genre::Mixed)
+      genreCounts[GenreIndex(genre)] += on ? 1 : -1;
+  };
+
+  // Rows in recording order (dense order changes when songs leave)
+  static std::vector<uint32_t> rows;
+
+  if (modelRevision != songsMade.Revision()) {
+    songsMade.InsertionOrder(rows);
+
+    std::vector<double> qualities(songsMade.Size());
+    for (size_t i = 0; i < qualities.size(); ++i)
+      qualities[i] = songsMade.At(i).quality;
+    albumModel.Reset(qualities);
+    genreCounts.fill(0);
+    for (size_t i = 0; i < qualities.size(); ++i) {
+      if (IsSelected(songsMade.HandleAt(i)))
+        Select(i, true);
+    }
+    modelRevision = songsMade.Revision();
   }
 
   // --- 4. ALBUM WORKSHOP (Restored Logic) ---
@@ -175,67 +214,79 @@ void DrawStudioWindow(Player &player, std::vector<Song> &songsMade,
   ImGui::InputText("##albumname", albumNameBuffer,
                    IM_ARRAYSIZE(albumNameBuffer));
 
-  // Gather selected tracks
-  std::vector<double> selectedQualities;
-  std::vector<int> selectedIndices;
-  std::string albumGenre = "Mixed";
-
-  for (int i = 0; i < (int)songsMade.size(); ++i) {
-    if (selectedSongs[i]) {
-      selectedQualities.push_back(songsMade[i].quality);
-      selectedIndices.push_back(i);
-      // Determine genre based on the first track selected (simple approach)
-      if (selectedIndices.size() == 1) {
-        albumGenre = songsMade[i].genre;
-      }
+  // Tracklist suggestion: replaces the selection with the best album the
+  // vault allows (for a track count, or any count up to the maximum)
+  static int suggestTracks = 0; // 0 = any count
+  static bool suggestCut = false; // Last search hit its time budget
+  ImGui::SetNextItemWidth(150);
+  ImGui::SliderInt("##suggesttracks", &suggestTracks, 0,
+                   static_cast<int>(TRACKLIST_MAX_TRACKS),
+                   suggestTracks == 0 ? "Any length" : "%d tracks");
+  ImGui::SameLine();
+  if (ImGui::Button("Suggest Tracklist") && !songsMade.Empty()) {
+    std::vector<double> qualities(songsMade.Size());
+    for (size_t i = 0; i < qualities.size(); ++i)
+      qualities[i] = songsMade.At(i).quality;
+
+    TracklistOptions options;
+    if (suggestTracks > 0) {
+      options.minTracks = static_cast<size_t>(suggestTracks);
+      options.maxTracks = options.minTracks;
+    }
+    TracklistResult best = FindBestTracklist(qualities, options);
+    if (!best.tracks.empty()) {
+      for (size_t i = 0; i < qualities.size(); ++i)
+        Select(i, false);
+      for (uint32_t i : best.tracks)
+        Select(i, true);
     }
+    suggestCut = !best.exact && !best.tracks.empty();
   }
+  if (suggestCut)
+    ImGui::TextDisabled("Best found in time (search was cut short).");
+
+  if (albumModel.Count() > 0) {
+    // Album genre = most used genre among the selected tracks
+    Genre albumGenre = GetAlbumGenre(genreCounts);
+
+    // Display Info (the forecast only reruns when its inputs change)
+    double estAlbumQual = albumModel.Estimate();
+    static double forecastQuality = -1.0;
+    static int forecastFans = -1;
+    static double forecastReputation = -1.0;
+    static double forecast = 0.0;
+    if (estAlbumQual != forecastQuality || player.fans != forecastFans ||
+        player.reputation != forecastReputation) {
+      forecastQuality = estAlbumQual;
+      forecastFans = player.fans;
+      forecastReputation = player.reputation;
+      forecast = ExpectedAlbumEarnings(estAlbumQual, player);
+    }
 
-  if (!selectedIndices.empty()) {
-    // Calculate Album Quality
-    double estAlbumQual = player.CalcAlbumQuality(selectedQualities);
-
-    // Display Info
-    ImGui::Text("%zu Tracks selected.", selectedIndices.size());
+    ImGui::Text("%zu Tracks selected.", albumModel.Count());
     ImGui::TextColored(ImVec4(0, 1, 1, 1), "Est. Album Quality: %.1f",
                        estAlbumQual);
-    ImGui::Text("Genre: %s", albumGenre.c_str());
+    ImGui::Text("Genre: %s", GenreName(albumGenre).data());
+    ImGui::Text("Expected earnings: $%.2f", forecast);
 
     // Release Button
     if (ImGui::Button("Release Album",
                       ImVec2(ImGui::GetContentRegionAvail().x, 0))) {
-
-      // 1. Copy songs to a new vector for the album
-      std::vector<Song> albumTracks;
-      for (int idx : selectedIndices) {
-        albumTracks.push_back(songsMade[idx]);
-      }
-      if (player.Energy >= 10.0) {
-        player.Energy -= 10.0;
-
-        // 2. Create the Album
-        // Constructor: Name, Artist, Genre, Tracks, Quality, Fans, Price
-        albumsReleased.emplace_back(
-            std::string(albumNameBuffer), player.name, albumGenre, albumTracks,
-            estAlbumQual, player.fans, GetRecommendedPrice(estAlbumQual, true));
-
-        // 3. Log it
-        if (albumTracks.size() < 6) {
-          gameLog.Add("Released EP: " + std::string(albumNameBuffer));
-        } else {
-          gameLog.Add("Released LP: " + std::string(albumNameBuffer));
+      // Tracks in recording order
+      std::vector<SlotHandle> selectedTracks;
+      selectedTracks.reserve(albumModel.Count());
+      for (uint32_t i : rows) {
+        if (albumModel.IsSelected(i)) {
+          selectedTracks.push_back(songsMade.HandleAt(i));
+          Select(i, false);
         }
-
-        // 4. CLEANUP: Remove songs from vault (Iterate BACKWARDS to avoid index
-        // shifting)
-        for (int i = (int)selectedIndices.size() - 1; i >= 0; --i) {
-          int targetIndex = selectedIndices[i];
-          songsMade.erase(songsMade.begin() + targetIndex);
-          selectedSongs.erase(selectedSongs.begin() + targetIndex);
-        }
-      } else {
-        gameLog.Add("Not enough energy to release album.");
       }
+
+      SimCommand command;
+      command.kind = SimCommandKind::ReleaseAlbum;
+      command.text = albumNameBuffer;
+      command.tracks = std::move(selectedTracks);
+      sim.Post(std::move(command));
     }
   } else {
     ImGui::TextDisabled("Select tracks in the vault below to form an album.");
@@ -244,53 +295,63 @@ void DrawStudioWindow(Player &player, std::vector<Song> &songsMade,
   ImGui::Separator();
 
   // --- 5. The Vault ---
-  ImGui::Text("The Vault (%zu songs)", songsMade.size());
+  ImGui::Text("The Vault (%zu songs)", songsMade.Size());
 
   ImGui::BeginChild("VaultScroll", ImVec2(0, 300), true);
-  for (size_t i = 0; i < songsMade.size();) {
-    ImGui::PushID((int)i);
+  // Only the visible rows are drawn, however many takes the vault holds
+  ImGuiListClipper clipper;
+  clipper.Begin(static_cast<int>(rows.size()));
+  while (clipper.Step()) {
+    for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+      const Song &song = songsMade.At(rows[row]);
+      SlotHandle handle = songsMade.HandleAt(rows[row]);
+      ImGui::PushID(static_cast<int>(handle.index));
+
+      // Checkbox Logic
+      bool isSelected = albumModel.IsSelected(rows[row]);
+      if (ImGui::Checkbox("##sel", &isSelected)) {
+        Select(rows[row], isSelected);
+      }
 
-    // Checkbox Logic
-    bool isSelected = selectedSongs[i];
-    if (ImGui::Checkbox("##sel", &isSelected)) {
-      selectedSongs[i] = isSelected;
-    }
+      ImGui::SameLine();
+      // Color code quality
+      ImVec4 qColor =
+          (song.quality > 70) ? ImVec4(0, 1, 0, 1) : ImVec4(1, 1, 1, 1);
+      ImGui::TextColored(qColor, "%-15s [%s]", stringPool.CStr(song.name),
+                         GenreName(song.genre).data());
+      ImGui::SameLine();
+      ImGui::Text("| Q: %.0f", song.quality);
 
-    ImGui::SameLine();
-    // Color code quality
-    ImVec4 qColor =
-        (songsMade[i].quality > 70) ? ImVec4(0, 1, 0, 1) : ImVec4(1, 1, 1, 1);
-    ImGui::TextColored(qColor, "%-15s [%s]", songsMade[i].name.c_str(),
-                       songsMade[i].genre.c_str());
-    ImGui::SameLine();
-    ImGui::Text("| Q: %.0f", songsMade[i].quality);
+      // Release Single Button
+      ImGui::SameLine(ImGui::GetWindowWidth() - 120);
+      if (ImGui::Button("Release Single")) {
+        Select(rows[row], false);
 
-    // Release Single Button
-    ImGui::SameLine(ImGui::GetWindowWidth() - 120);
-    if (ImGui::Button("Release Single")) {
-      songsReleased.push_back(songsMade[i]);
-      gameLog.Add("Released Single: " + songsMade[i].name);
+        SimCommand command;
+        command.kind = SimCommandKind::ReleaseSingle;
+        command.song = handle;
+        sim.Post(std::move(command));
+      }
 
-      songsMade.erase(songsMade.begin() + i);
-      selectedSongs.erase(selectedSongs.begin() + i);
       ImGui::PopID();
-      continue;
     }
-
-    ImGui::PopID();
-    i++;
   }
   ImGui::EndChild();
 
   ImGui::End();
 }
 
-void DrawAnalyticsWindow(const std::vector<Song> &songsReleased,
-                         const std::vector<Album> &albumsReleased) {
+void DrawAnalyticsWindow(const WorldSnapshot &view) {
   if (ImGui::Begin("Charts & Analytics")) {
-    if (songsReleased.empty() && albumsReleased.empty()) {
+    size_t releases = view.songCount + view.albumCount;
+    if (releases == 0) {
       ImGui::TextDisabled("No releases yet.");
     } else {
+      ImGui::Text("%zu singles, %zu albums live", view.songCount,
+                  view.albumCount);
+      if (releases > view.chart.size())
+        ImGui::TextDisabled("Showing the newest %zu", view.chart.size());
+
       if (ImGui::BeginTable("Charts", 5,
                             ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
                                 ImGuiTableFlags_ScrollY)) {
@@ -301,75 +362,47 @@ void DrawAnalyticsWindow(const std::vector<Song> &songsReleased,
         ImGui::TableSetupColumn("Rev");
         ImGui::TableHeadersRow();
 
-        // 1. Setup Reverse Iterators (Start at the newest items)
-        auto s_it = songsReleased.rbegin();
-        auto s_end = songsReleased.rend();
-        auto a_it = albumsReleased.rbegin();
-        auto a_end = albumsReleased.rend();
-
-        // 2. Loop until both lists are exhausted
-        while (s_it != s_end || a_it != a_end) {
-          bool drawSong = false;
-
-          // DECISION LOGIC: Which one is newer?
-          if (s_it == s_end) {
-            drawSong = false; // No more songs, draw album
-          } else if (a_it == a_end) {
-            drawSong = true; // No more albums, draw song
-          } else {
-            // Both exist: Draw the one with LOWER lifeTime (Newer)
-            if (s_it->lifeTime < a_it->lifeTime) {
-              drawSong = true;
-            } else {
-              drawSong = false;
-            }
-          }
-
-          ImGui::TableNextRow();
-
-          if (drawSong) {
-            // --- DRAW SONG ROW ---
-            const auto &song = *s_it;
-
-            ImGui::TableSetColumnIndex(0);
-            ImGui::Text("Song: %s", song.name.c_str());
-
-            ImGui::TableSetColumnIndex(1);
-            ImGui::ProgressBar(std::clamp((float)song.hype, 0.0f, 1.0f),
-                               ImVec2(-1, 0));
-
-            ImGui::TableSetColumnIndex(2);
-            ImGui::Text("%d (+%d)", song.totalStreams, song.dailyStreams);
-
-            ImGui::TableSetColumnIndex(3);
-            ImGui::Text("%d", song.totalSales);
-
-            ImGui::TableSetColumnIndex(4);
-            ImGui::Text("$%.2f", song.earnings);
-
-            ++s_it; // Move to next song
-          } else {
-            // --- DRAW ALBUM ROW ---
-            const auto &album = *a_it;
+        // Rows arrive newest first (SimulationThread merges the catalogs);
+        // only the visible ones are drawn
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(view.chart.size()));
+        while (clipper.Step()) {
+          for (int r = clipper.DisplayStart; r < clipper.DisplayEnd; ++r) {
+            const ChartRow &row = view.chart[r];
+            ImGui::TableNextRow();
 
             ImGui::TableSetColumnIndex(0);
-            ImGui::TextColored(ImVec4(0.8f, 0.8f, 1.0f, 1.0f), "Album: %s",
-                               album.name.c_str());
+            if (!row.album) {
+              ImGui::Text("Song: %s", stringPool.CStr(row.name));
+            } else {
+              ImGui::TextColored(ImVec4(0.8f, 0.8f, 1.0f, 1.0f), "Album: %s",
+                                 stringPool.CStr(row.name));
+
+              // Per-track breakdown, attributed from the album's totals
+              if (ImGui::IsItemHovered() && ImGui::BeginTooltip()) {
+                for (uint32_t k = 0; k < row.trackCount; ++k) {
+                  const ChartTrack &track =
+                      view.chartTracks[row.firstTrack + k];
+                  ImGui::Text("%2u. %-24s Q %3.0f  %8.0f streams  $%.2f",
+                              k + 1, stringPool.CStr(track.name),
+                              track.quality, track.streams, track.earnings);
+                }
+                ImGui::EndTooltip();
+              }
+            }
 
             ImGui::TableSetColumnIndex(1);
-            ImGui::ProgressBar(std::clamp((float)album.hype, 0.0f, 1.0f),
+            ImGui::ProgressBar(std::clamp((float)row.hype, 0.0f, 1.0f),
                                ImVec2(-1, 0));
 
             ImGui::TableSetColumnIndex(2);
-            ImGui::Text("%d (+%d)", album.totalStreams, album.dailyStreams);
+            ImGui::Text("%d (+%d)", row.totalStreams, row.dailyStreams);
 
             ImGui::TableSetColumnIndex(3);
-            ImGui::Text("%d", album.totalSales);
+            ImGui::Text("%d", row.totalSales);
 
             ImGui::TableSetColumnIndex(4);
-            ImGui::Text("$%.2f", album.earnings);
-
-            ++a_it; // Move to next album
+            ImGui::Text("$%.2f", row.earnings);
           }
         }
 
@@ -384,25 +417,30 @@ void DrawAnalyticsWindow(const std::vector<Song> &songsReleased,
 #include <imgui.h>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <utility> // For std::pair
 #include <vector>
 
 // Assuming GameLog and Player are defined elsewhere as per your snippet
 // extern GameLog gameLog;
 
-void DrawUpgradeWindow(const char *title, Player &player,
-                       std::vector<std::pair<std::string, double>> &items) {
+void DrawUpgradeWindow(const char *title, const WorldSnapshot &view,
+                       SimulationThread &sim) {
 
   // C++20: Use string_view for efficient comparison
   bool IsSkillWindow = (std::string_view(title) == "Skills");
 
+  const Player &player = view.player;
+  size_t itemCount = IsSkillWindow ? SKILL_COUNT : TOOL_COUNT;
+
   if (ImGui::Begin(title)) {
     ImGui::Text("Funds: $%.2f", player.money);
     ImGui::Separator();
 
     // C++20: Structured binding for cleaner loop access
-    for (size_t i = 0; i < items.size(); ++i) {
-      auto &[name, level] = items[i];
+    for (size_t i = 0; i < itemCount; ++i) {
+      std::string_view name = IsSkillWindow ? SKILL_NAMES[i] : TOOL_NAMES[i];
+      double level = IsSkillWindow ? player.Skills()[i] : player.Tools()[i];
 
       ImGui::PushID((int)i);
 
@@ -410,8 +448,8 @@ void DrawUpgradeWindow(const char *title, Player &player,
       ImGui::AlignTextToFramePadding();
 
       // Draw the Item Name and Level
-      ImGui::TextColored(ImVec4(0.4f, 0.8f, 1.0f, 1.0f), "%s (Lvl %.1f)",
-                         name.c_str(), level);
+      ImGui::TextColored(ImVec4(0.4f, 0.8f, 1.0f, 1.0f), "%.*s (Lvl %.1f)",
+                         static_cast<int>(name.size()), name.data(), level);
 
       // FIX: This moves the cursor back up to the line of the text
       // so the buttons appear on the side, not below.
@@ -420,6 +458,17 @@ void DrawUpgradeWindow(const char *title, Player &player,
       // ---------------------------------------------------------
       // Upgrade Button Lambda
       // ---------------------------------------------------------
+      // Money is checked again when the simulation applies it
+      auto PostUpgrade = [&](double cost, double gain) {
+        SimCommand command;
+        command.kind = SimCommandKind::Upgrade;
+        command.skill = IsSkillWindow;
+        command.index = i;
+        command.cost = cost;
+        command.gain = gain;
+        sim.Post(std::move(command));
+      };
+
       auto DrawUpgradeBtn = [&](const char *label, double cost, double gain) {
         bool cannotAfford = (player.money < cost);
 
@@ -427,14 +476,7 @@ void DrawUpgradeWindow(const char *title, Player &player,
           ImGui::BeginDisabled();
 
         if (ImGui::Button(label)) {
-          player.money -= cost;
-          level += gain;
-
-          if (IsSkillWindow) {
-            gameLog.Add("Learned " + name);
-          } else {
-            gameLog.Add("Upgraded");
-          }
+          PostUpgrade(cost, gain);
         }
 
         if (cannotAfford)
@@ -448,7 +490,7 @@ void DrawUpgradeWindow(const char *title, Player &player,
       // 1. First Button (Free Study or Minor Upgrade)
       if (IsSkillWindow) {
         if (ImGui::Button("Study (Free)")) {
-          level += 0.1;
+          PostUpgrade(0.0, 0.1);
         }
       } else {
         DrawUpgradeBtn("Minor Upgrade", 10.0, 1.0);
@@ -480,12 +522,17 @@ void DrawUpgradeWindow(const char *title, Player &player,
   ImGui::End();
 }
 
-void DrawMainMenu(GameState &state, Player &player) {
+// Single save slot next to the executable
+static constexpr const char *SAVE_PATH = "savegame.mts";
+
+void DrawMainMenu(GameState &state, World &world) {
+  Player &player = world.player;
+
   // Center the window
   ImGui::SetNextWindowPos(ImVec2(ImGui::GetIO().DisplaySize.x * 0.5f,
                                  ImGui::GetIO().DisplaySize.y * 0.5f),
                           ImGuiCond_Always, ImVec2(0.5f, 0.5f));
-  ImGui::SetNextWindowSize(ImVec2(400, 300));
+  ImGui::SetNextWindowSize(ImVec2(400, 340));
 
   ImGui::Begin("Music Tycoon - Main Menu", nullptr,
                ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoResize |
@@ -505,6 +552,18 @@ void DrawMainMenu(GameState &state, Player &player) {
     state = GameState::Playing; // Switch to the game!
   }
 
+  static std::string loadError;
+  if (ImGui::Button("CONTINUE (Load Save)", ImVec2(-1, 30))) {
+    if (LoadWorld(world, SAVE_PATH, loadError)) {
+      gameLog.Add(LogMessage::LoadedCareer, {.text = world.player.name});
+      std::snprintf(nameBuf, sizeof(nameBuf), "%s", world.player.name.c_str());
+      loadError.clear();
+      state = GameState::Playing;
+    }
+  }
+  if (!loadError.empty())
+    ImGui::TextColored(ImVec4(1, 0.3f, 0.3f, 1), "%s", loadError.c_str());
+
   if (ImGui::Button("QUIT", ImVec2(-1, 30))) {
     exit(0);
   }
@@ -513,7 +572,7 @@ void DrawMainMenu(GameState &state, Player &player) {
 
   ImGui::End();
 }
-void DrawActionsWindow(Player &player) {
+void DrawActionsWindow(SimulationThread &sim) {
   static float timeBusking = 0.0f;
 
   // 1. Setup Style Variables for this window only (Rounded corners, padding)
@@ -580,7 +639,10 @@ void DrawActionsWindow(Player &player) {
                               ImVec4(0.1f, 0.5f, 0.1f, 1.0f));
 
         if (ImGui::Button("START BUSKING", ImVec2(140.0f, 40.0f))) {
-          player.Busk(timeBusking);
+          SimCommand command;
+          command.kind = SimCommandKind::Busk;
+          command.amount = timeBusking;
+          sim.Post(std::move(command));
         }
 
         ImGui::PopStyleColor(3);
@@ -612,7 +674,9 @@ void DrawActionsWindow(Player &player) {
                             ImVec4(0.3f, 0.5f, 0.8f, 1.0f));
 
       if (ImGui::Button("REST NOW", ImVec2(140.0f, 40.0f))) {
-        player.Rest();
+        SimCommand command;
+        command.kind = SimCommandKind::Rest;
+        sim.Post(std::move(command));
       }
 
       ImGui::PopStyleColor(2);
@@ -624,4 +688,67 @@ void DrawActionsWindow(Player &player) {
 
   // Pop the window styles we pushed at the start
   ImGui::PopStyleVar(3);
-}
\ No newline at end of file
+}
+
+void DrawSaveWindow(SimulationThread &sim) {
+  // Both run on the simulation thread between ticks; the result shows up in
+  // the news feed
+  if (ImGui::Begin("Career")) {
+    if (ImGui::Button("Save Game")) {
+      SimCommand command;
+      command.kind = SimCommandKind::Save;
+      command.text = SAVE_PATH;
+      sim.Post(std::move(command));
+    }
+
+    ImGui::SameLine();
+    if (ImGui::Button("Load Game")) {
+      SimCommand command;
+      command.kind = SimCommandKind::Load;
+      command.text = SAVE_PATH;
+      sim.Post(std::move(command));
+    }
+  }
+  ImGui::End();
+}
+
+void DrawSpeedWindow(const WorldSnapshot &view, SimulationThread &sim) {
+  if (ImGui::Begin("Simulation")) {
+    // 1. Pause / resume
+    if (ImGui::Button(view.paused ? "Resume" : "Pause", ImVec2(80, 0))) {
+      sim.SetPaused(!view.paused);
+    }
+
+    // 2. Speed (log scale, so 1x-10x is as easy to hit as 100x-1000x)
+    ImGui::SameLine();
+    static float speed = 1.0f;
+    if (ImGui::SliderFloat("Speed", &speed, SimulationThread::MIN_SPEED,
+                           SimulationThread::MAX_SPEED, "%.0fx",
+                           ImGuiSliderFlags_Logarithmic)) {
+      sim.SetSpeed(speed);
+    }
+
+    // 3. Clock
+    ImGui::Text("Day %llu (%.0f s game time)",
+                static_cast<unsigned long long>(view.tick), view.gameSeconds);
+    if (view.lagging) {
+      ImGui::TextColored(ImVec4(1, 0.5f, 0, 1),
+                         "Simulation cannot keep up with %.0fx", view.speed);
+    }
+
+    // 4. Skip ahead (idle stretches are fast-forwarded analytically)
+    const std::pair<const char *, size_t> skips[] = {
+        {"Skip Week", 7}, {"Skip Month", 30}, {"Skip Year", 365}};
+    for (size_t i = 0; i < std::size(skips); ++i) {
+      if (i > 0)
+        ImGui::SameLine();
+      if (ImGui::Button(skips[i].first)) {
+        SimCommand command;
+        command.kind = SimCommandKind::FastForward;
+        command.index = skips[i].second;
+        sim.Post(std::move(command));
+      }
+    }
+  }
+  ImGui::End();
+}
@@ -1,7 +1,9 @@
 #include "../headers/helper.h"
 #include "../headers/config.h"
 
-#include <random>
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -10,28 +12,37 @@
 // --- MODERN RANDOM ENGINE ---
 namespace Random {
 
-std::mt19937 mt(std::random_device{}());
+namespace {
+uint64_t sessionSeed = DEFAULT_SEED;
+RandomStream session(DEFAULT_SEED, RngStream::Session);
+thread_local RandomStream *current = nullptr;
+} // namespace
 
-double Normal(double mean, double stdDev) {
-  std::normal_distribution<double> dist(mean, stdDev);
-  return dist(mt);
+void Seed(uint64_t seed) {
+  sessionSeed = seed;
+  session = RandomStream(seed, RngStream::Session);
 }
 
-// Returns integer between min and max (inclusive)
-int Int(int min, int max) {
-  std::uniform_int_distribution<int> dist(min, max);
-  return dist(mt);
-}
+uint64_t GetSeed() { return sessionSeed; }
+
+RandomStream &Current() { return current ? *current : session; }
 
-double Double(double min, double max) {
-  std::uniform_real_distribution<double> dist(min, max);
-  return dist(mt);
+StreamScope::StreamScope(RandomStream &stream) : previous(current) {
+  current = &stream;
 }
 
-bool Chance(double probability01) {
-  std::bernoulli_distribution dist(probability01);
-  return dist(mt);
+StreamScope::~StreamScope() { current = previous; }
+
+double Normal(double mean, double stdDev) {
+  return Current().Normal(mean, stdDev);
 }
+
+// Returns integer between min and max (inclusive)
+int Int(int min, int max) { return Current().Int(min, max); }
+
+double Double(double min, double max) { return Current().Double(min, max); }
+
+bool Chance(double probability01) { return Current().Chance(probability01); }
 } // namespace Random
 
 std::string GenerateSongName() {
@@ -267,87 +278,21 @@ std::string GenerateSongName() {
   return songNames[Random::Int(0, static_cast<int>(songNames.size()) - 1)];
 }
 
-std::string GetAlbumGenre() {
-  std::vector<std::string> genres = {
-      "Pop",       "Rock",  "Hip-Hop",     "R&B",     "Jazz",
-      "Classical", "Other", "Electronic",  "Country", "Folk",
-      "Metal",     "Indie", "Experimental"};
-
-  // calculate most used genre in album
-  int popCount = 0;
-  int rockCount = 0;
-  int hipHopCount = 0;
-  int rnbCount = 0;
-  int jazzCount = 0;
-  int classicalCount = 0;
-  int otherCount = 0;
-  int electronicCount = 0;
-  int countryCount = 0;
-  int folkCount = 0;
-  int metalCount = 0;
-  int indieCount = 0;
-  int experimentalCount = 0;
-
-  for (int i = 0; i < 5; i++) {
-    if (genres[i] == "Pop") {
-      popCount++;
-    } else if (genres[i] == "Rock") {
-      rockCount++;
-    } else if (genres[i] == "Hip-Hop") {
-      hipHopCount++;
-    } else if (genres[i] == "R&B") {
-      rnbCount++;
-    } else if (genres[i] == "Jazz") {
-      jazzCount++;
-    } else if (genres[i] == "Classical") {
-      classicalCount++;
-    } else if (genres[i] == "Other") {
-      otherCount++;
-    } else if (genres[i] == "Electronic") {
-      electronicCount++;
-    } else if (genres[i] == "Country") {
-      countryCount++;
-    } else if (genres[i] == "Folk") {
-      folkCount++;
-    } else if (genres[i] == "Metal") {
-      metalCount++;
-    } else if (genres[i] == "Indie") {
-      indieCount++;
-    } else if (genres[i] == "Experimental") {
-      experimentalCount++;
-    }
+Genre GetAlbumGenre(const std::vector<Genre> &trackGenres) {
+  // calculate most used genre in album (ties go to the earlier genre)
+  std::array<int, GENRE_COUNT> counts{};
+  for (Genre genre : trackGenres) {
+    if (genre != Genre::Mixed)
+      counts[GenreIndex(genre)]++;
   }
+  return GetAlbumGenre(counts);
+}
 
-  int mostUsed =
-      std::max({popCount, rockCount, hipHopCount, rnbCount, jazzCount});
-
-  if (mostUsed == popCount) {
-    return "Pop";
-  } else if (mostUsed == rockCount) {
-    return "Rock";
-  } else if (mostUsed == hipHopCount) {
-    return "Hip-Hop";
-  } else if (mostUsed == rnbCount) {
-    return "R&B";
-  } else if (mostUsed == jazzCount) {
-    return "Jazz";
-  } else if (mostUsed == classicalCount) {
-    return "Classical";
-  } else if (mostUsed == otherCount) {
-    return "Other";
-  } else if (mostUsed == electronicCount) {
-    return "Electronic";
-  } else if (mostUsed == countryCount) {
-    return "Country";
-  } else if (mostUsed == folkCount) {
-    return "Folk";
-  } else if (mostUsed == metalCount) {
-    return "Metal";
-  } else if (mostUsed == indieCount) {
-    return "Indie";
-  } else if (mostUsed == experimentalCount) {
-    return "Experimental";
-  }
+Genre GetAlbumGenre(const std::array<int, GENRE_COUNT> &genreCounts) {
+  auto mostUsed = std::max_element(genreCounts.begin(), genreCounts.end());
+  if (*mostUsed == 0)
+    return Genre::Mixed;
+  return GenreAt(static_cast<size_t>(mostUsed - genreCounts.begin()));
 }
 
 double GetRecommendedPrice(double quality, bool IsAlbum) {
@@ -1,21 +1,37 @@
-#include "../headers/album.h"
+#include "../headers/catalog.h"
 #include "../headers/config.h"
 #include "../headers/graphics.h"
+#include "../headers/helper.h"
 #include "../headers/player.h"
-#include "../headers/simulation.h"
+#include "../headers/replay.h"
+#include "../headers/Simulation.h"
+#include "../headers/simthread.h"
 #include "../headers/song.h"
+#include "../headers/world.h"
 
 #include "imgui-SFML.h"
 
 #include <SFML/Graphics.hpp>
 #include <SFML/System/Time.hpp>
 
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <optional>
+#include <random>
 #include <string>
 #include <vector>
 
-int main() {
+// Recordings kept in RecordingDirectory(), this session's included
+static constexpr size_t RECORDINGS_KEPT = 10;
+
+int main(int argc, char **argv) {
+  // --no-record: play without writing a session recording
+  bool record = true;
+  for (int i = 1; i < argc; ++i)
+    if (std::strcmp(argv[i], "--no-record") == 0)
+      record = false;
+
   // SFML 3.0 Window Creation
   sf::RenderWindow window(sf::VideoMode({1800, 1000}), "Music Tycoon 2025");
   window.setFramerateLimit(60);
@@ -26,18 +42,36 @@ int main() {
   // Game Variables
   GameState currentState = GameState::MainMenu;
 
-  // 2. CREATE TIMER (Before the loop)
-  auto globalTickTimer = std::make_shared<float>(0.0f);
+  // 2. SEED & WORLD
+  // One seed drives every random draw; log it so a session can be replayed.
+  std::random_device entropy;
+  uint64_t seed = (static_cast<uint64_t>(entropy()) << 32) | entropy();
+  Random::Seed(seed);
+
+  // The world owns the player, vault, catalogs, timer and market state (and
+  // is what Save/Load writes and restores).
+  World world(seed, "name");
+  world.log = &gameLog;
+
+  // Once the career starts, the world (and gameLog) belong to this thread;
+  // the windows draw its snapshots and post commands to it.
+  SimulationThread sim(world);
+
+  // Unless --no-record, every session is recorded to its own file in
+  // RecordingDirectory() (MusicTycoonSim --replay FILE runs it again),
+  // starting from the world as the career starts
+  InputRecorder recorder;
 
-  Player player("name");
-  std::vector<Song> songsMade;
-  std::vector<Song> songsReleased;
-  std::vector<Album> albumsReleased;
+  // UI-only draws (random song names) use their own stream, so the world's
+  // session stream stays on the simulation thread
+  RandomStream uiRng(seed, RngStream::Session, 1);
+  Random::StreamScope uiScope(uiRng);
 
   sf::Clock deltaClock;
 
   // 3. LOG INITIALIZATION
-  gameLog.Add("Engine Initialized.");
+  gameLog.Add(LogMessage::EngineInitialized,
+              {.number = static_cast<int64_t>(seed)});
 
   while (window.isOpen()) {
     // SFML 3.0 Event Polling
@@ -54,39 +88,40 @@ int main() {
     // --- GAME STATE MACHINE ---
     switch (currentState) {
     case GameState::MainMenu: {
-      DrawMainMenu(currentState, player);
+      DrawMainMenu(currentState, world);
       break;
     }
 
     case GameState::Playing: {
       // --- Logic ---
-      // 4. CALL SIMULATION (Pass global timer)
-      SimulateEconomy(songsReleased, albumsReleased, player, dt,
-                      globalTickTimer);
-
-      bool updated = UpdateReputation(player, songsReleased, albumsReleased,
-                                      globalTickTimer);
-
-      // Clean up old songs (C++20 erase_if)
-      std::erase_if(songsReleased, [](const Song &s) {
-        return s.lifeTime >= EconomyConfig::SONG_LIFETIME.asSeconds();
-      });
-
-      // Clean up old albums
-      std::erase_if(albumsReleased, [](const Album &a) {
-        return a.lifeTime >= EconomyConfig::ALBUM_LIFETIME.asSeconds();
-      });
+      // 4. SIMULATION (economy, reputation, expiry) runs on its own thread
+      // at a fixed timestep; a slow frame here no longer costs ticks
+      if (!sim.Running()) {
+        std::string path, error;
+        if (record) {
+          if (NextRecordingPath(RecordingDirectory(), RECORDINGS_KEPT, path,
+                                error) &&
+              recorder.Open(path, world, error))
+            sim.Record(&recorder);
+          else
+            gameLog.Add(LogMessage::RecordingFailed, {.text = error});
+        }
+        sim.Start();
+      }
 
       // --- Drawing UI ---
-      DrawStudioWindow(player, songsMade, songsReleased, albumsReleased);
-      DrawAnalyticsWindow(songsReleased, albumsReleased);
+      const WorldSnapshot &view = sim.Acquire();
+      DrawStudioWindow(view, sim);
+      DrawAnalyticsWindow(view);
 
-      DrawUpgradeWindow("Skills", player, player.skills);
-      DrawUpgradeWindow("Studio Gear", player, player.studio_tools);
-      DrawActionsWindow(player);
+      DrawUpgradeWindow("Skills", view, sim);
+      DrawUpgradeWindow("Studio Gear", view, sim);
+      DrawActionsWindow(sim);
+      DrawSaveWindow(sim);
+      DrawSpeedWindow(view, sim);
 
-      // 5. DRAW LOG WINDOW (Fixed typo: gamelog -> gameLog)
-      gameLog.DrawWindow(dt, globalTickTimer);
+      // 5. DRAW LOG WINDOW (snapshot of gameLog)
+      view.log.DrawWindow(dt.asSeconds(), view.market);
 
       break;
     }
@@ -98,6 +133,8 @@ int main() {
     window.display();
   }
 
+  sim.Stop();
+  recorder.Close(world);
   ImGui::SFML::Shutdown();
   return 0;
 }
\ No newline at end of file
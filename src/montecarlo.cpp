@@ -0,0 +1,131 @@
+#include "../headers/montecarlo.h"
+#include "../headers/config.h"
+#include "../headers/helper.h"
+#include "../headers/rng.h"
+#include "../headers/song.h"
+#include "../headers/threadpool.h"
+#include "../headers/world.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace {
+
+Song MakeSingle(const World &world, const CareerPlan &plan) {
+  double quality = plan.quality > 0.0 ? std::clamp(plan.quality, 1.0, 100.0)
+                                      : world.player.CalcQuality();
+  return Song(GenerateSongName(), world.player.name, Genre::Pop, quality,
+              world.player.fans, GetRecommendedPrice(quality, false));
+}
+
+CareerOutcome RunCareer(const CareerPlan &plan, uint64_t careerSeed) {
+  World world(careerSeed);
+  world.player.fans = plan.fans;
+  world.player.money = plan.money;
+
+  CareerOutcome outcome;
+  {
+    Random::StreamScope scope(world.rng);
+    for (int i = 0; i < plan.startingSongs; ++i)
+      world.songs.Add(MakeSingle(world, plan));
+  }
+
+  constexpr float dt = EconomyConfig::ECONOMY_TICK_RATE;
+  for (long long tick = 0; tick < plan.ticks; ++tick) {
+    if (plan.releaseEvery > 0 && tick % plan.releaseEvery == 0) {
+      Random::StreamScope scope(world.rng);
+      world.songs.Add(MakeSingle(world, plan));
+      ++outcome.releases;
+    }
+    StepWorld(world, dt);
+  }
+
+  outcome.money = world.player.money;
+  outcome.fans = world.player.fans;
+  outcome.reputation = world.player.reputation;
+  return outcome;
+}
+
+} // namespace
+
+Distribution Summarize(std::vector<double> values, size_t histogramBins) {
+  Distribution dist;
+  if (values.empty())
+    return dist;
+
+  // 1. Order statistics
+  std::sort(values.begin(), values.end());
+  const size_t n = values.size();
+  dist.min = values.front();
+  dist.max = values.back();
+
+  for (size_t p = 0; p < Distribution::PERCENTILES.size(); ++p) {
+    double rank = Distribution::PERCENTILES[p] / 100.0 * (n - 1);
+    size_t lower = static_cast<size_t>(rank);
+    size_t upper = std::min(lower + 1, n - 1);
+    double frac = rank - lower;
+    dist.percentiles[p] = values[lower] + (values[upper] - values[lower]) * frac;
+  }
+
+  // 2. Moments (sorted order, so the result is reproducible)
+  double sum = 0.0;
+  for (double v : values)
+    sum += v;
+  dist.mean = sum / n;
+
+  double squares = 0.0;
+  for (double v : values)
+    squares += (v - dist.mean) * (v - dist.mean);
+  dist.stdDev = std::sqrt(squares / n);
+
+  // 3. Histogram
+  histogramBins = std::max<size_t>(1, histogramBins);
+  dist.histogram.assign(histogramBins, 0);
+  dist.binWidth = (dist.max - dist.min) / histogramBins;
+  for (double v : values) {
+    size_t bin = dist.binWidth > 0.0
+                     ? static_cast<size_t>((v - dist.min) / dist.binWidth)
+                     : 0;
+    ++dist.histogram[std::min(bin, histogramBins - 1)];
+  }
+
+  return dist;
+}
+
+MonteCarloReport RunMonteCarlo(const CareerPlan &plan, size_t careers,
+                               uint64_t seed, size_t histogramBins) {
+  MonteCarloReport report;
+  report.outcomes.resize(careers);
+
+  auto start = std::chrono::steady_clock::now();
+
+  // One task per career. Each career runs its own ticks serially; the
+  // parallelism is across careers.
+  SharedThreadPool().ParallelFor(careers, [&](size_t career) {
+    uint64_t careerSeed =
+        RandomStream(seed, RngStream::Career, career).NextU64();
+    report.outcomes[career] = RunCareer(plan, careerSeed);
+  });
+
+  auto end = std::chrono::steady_clock::now();
+  report.wallSeconds = std::chrono::duration<double>(end - start).count();
+
+  std::vector<double> money, fans, reputation;
+  money.reserve(careers);
+  fans.reserve(careers);
+  reputation.reserve(careers);
+  for (const CareerOutcome &outcome : report.outcomes) {
+    money.push_back(outcome.money);
+    fans.push_back(outcome.fans);
+    reputation.push_back(outcome.reputation);
+  }
+
+  report.money = Summarize(std::move(money), histogramBins);
+  report.fans = Summarize(std::move(fans), histogramBins);
+  report.reputation = Summarize(std::move(reputation), histogramBins);
+  return report;
+}
@@ -0,0 +1,281 @@
+#include "../headers/performance.h"
+#include "../headers/config.h"
+#include "../headers/helper.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+// SIMD paths are only built for x86-64, where SSE2 is always available and
+// AVX2 is picked at runtime. Everything else runs the scalar path.
+#if defined(__x86_64__) || defined(_M_X64)
+#define MUSICTYCOON_X86_SIMD 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define MUSICTYCOON_TARGET_AVX2
+#else
+#define MUSICTYCOON_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace {
+
+// Model constants (kept identical to the original CalculatePerformance)
+constexpr double SONG_DECAY_SPEED = 120.0;
+constexpr double ALBUM_DECAY_SPEED = 200.0;
+constexpr double SONG_CONVERSION = 1.0 / 600.0;
+constexpr double ALBUM_CONVERSION = 1.0 / 1000.0;
+constexpr double PRICE_CLIFF = 1.5;
+
+// --- 1. SCALAR REFERENCE ---
+// The exact original math (std::exp) with CurveMode::Exact; other paths are
+// measured against that. CurveMode::Table takes freshness from its table.
+void EvaluateScalar(const PerformanceBatch &batch) {
+  const CurveMode curves = batch.curves;
+  for (size_t i = 0; i < batch.count; ++i) {
+    // B. Freshness Curve
+    double ageFactor =
+        FreshnessCurve(batch.lifeTime[i] / batch.decayTime[i], curves);
+
+    // D. Organic Discovery
+    batch.organic[i] = batch.viralBase[i] * batch.qualityPower[i] *
+                       batch.trendBonus[i] * ageFactor * batch.hype[i];
+  }
+}
+
+} // namespace
+
+PerformanceCurve EvaluatePerformanceCurve(double quality, double price,
+                                          bool isAlbum, CurveMode curves) {
+  const double decaySpeed = isAlbum ? ALBUM_DECAY_SPEED : SONG_DECAY_SPEED;
+  const double baseConversion = isAlbum ? ALBUM_CONVERSION : SONG_CONVERSION;
+  PerformanceCurve curve;
+
+  // B. Freshness Curve
+  double qualityPreservation = std::max(1.0, quality / 20.0);
+  curve.decayTime = decaySpeed * qualityPreservation;
+
+  // C. Price Elasticity
+  double recommendedPrice = GetRecommendedPrice(quality, isAlbum);
+  double priceRatio = price / std::max(0.01, recommendedPrice);
+  if (curves == CurveMode::Exact) {
+    curve.demand =
+        (priceRatio > PRICE_CLIFF)
+            ? std::pow(priceRatio, -3.0)
+            : std::pow(priceRatio, -EconomyConfig::PRICE_ELASTICITY);
+  } else {
+    static_assert(EconomyConfig::PRICE_ELASTICITY == 2.5);
+    double ratio2 = priceRatio * priceRatio;
+    curve.demand = (priceRatio > PRICE_CLIFF)
+                       ? 1.0 / (ratio2 * priceRatio)
+                       : 1.0 / (ratio2 * std::sqrt(priceRatio));
+  }
+
+  // D. Organic Discovery
+  curve.qualityPower = DiscoveryCurve(quality, curves);
+
+  // E. Sales Conversion
+  curve.salesChance = baseConversion * (quality / 50.0) * curve.demand;
+  return curve;
+}
+
+namespace {
+
+#ifdef MUSICTYCOON_X86_SIMD
+
+// --- 2. VECTOR MATH ---
+// exp(x) = 2^n * exp(r), with n = round(x / ln2) and |r| <= ln2 / 2.
+// exp(r) uses a degree-12 Taylor polynomial (truncation < 2e-16), and 2^n is
+// built straight into the exponent bits. Relative error stays below ~1e-14.
+constexpr double EXP_MIN = -700.0;
+constexpr double EXP_MAX = 700.0;
+constexpr double LOG2E = 1.4426950408889634074;
+constexpr double LN2_HI = 0.693147180369123816490;
+constexpr double LN2_LO = 1.90821492927058770002e-10;
+constexpr double EXP_COEFFS[] = {
+    1.0 / 479001600.0, 1.0 / 39916800.0, 1.0 / 3628800.0, 1.0 / 362880.0,
+    1.0 / 40320.0,     1.0 / 5040.0,     1.0 / 720.0,     1.0 / 120.0,
+    1.0 / 24.0,        1.0 / 6.0,        1.0 / 2.0,       1.0,
+    1.0};
+
+__m128d ExpSSE2(__m128d x) {
+  x = _mm_min_pd(_mm_max_pd(x, _mm_set1_pd(EXP_MIN)), _mm_set1_pd(EXP_MAX));
+
+  __m128i n = _mm_cvtpd_epi32(_mm_mul_pd(x, _mm_set1_pd(LOG2E)));
+  __m128d nd = _mm_cvtepi32_pd(n);
+  __m128d r = _mm_sub_pd(x, _mm_mul_pd(nd, _mm_set1_pd(LN2_HI)));
+  r = _mm_sub_pd(r, _mm_mul_pd(nd, _mm_set1_pd(LN2_LO)));
+
+  __m128d p = _mm_set1_pd(EXP_COEFFS[0]);
+  for (size_t c = 1; c < std::size(EXP_COEFFS); ++c)
+    p = _mm_add_pd(_mm_mul_pd(p, r), _mm_set1_pd(EXP_COEFFS[c]));
+
+  // Biased exponent (n + 1023) is always positive after the clamp above
+  __m128i biased = _mm_add_epi32(n, _mm_set1_epi32(1023));
+  __m128i wide = _mm_unpacklo_epi32(biased, _mm_setzero_si128());
+  __m128d pow2n = _mm_castsi128_pd(_mm_slli_epi64(wide, 52));
+  return _mm_mul_pd(p, pow2n);
+}
+
+MUSICTYCOON_TARGET_AVX2 __m256d ExpAVX2(__m256d x) {
+  x = _mm256_min_pd(_mm256_max_pd(x, _mm256_set1_pd(EXP_MIN)),
+                    _mm256_set1_pd(EXP_MAX));
+
+  __m256d t = _mm256_mul_pd(x, _mm256_set1_pd(LOG2E));
+  __m128i n = _mm256_cvtpd_epi32(t);
+  __m256d nd = _mm256_cvtepi32_pd(n);
+  __m256d r = _mm256_sub_pd(x, _mm256_mul_pd(nd, _mm256_set1_pd(LN2_HI)));
+  r = _mm256_sub_pd(r, _mm256_mul_pd(nd, _mm256_set1_pd(LN2_LO)));
+
+  __m256d p = _mm256_set1_pd(EXP_COEFFS[0]);
+  for (size_t c = 1; c < std::size(EXP_COEFFS); ++c)
+    p = _mm256_add_pd(_mm256_mul_pd(p, r), _mm256_set1_pd(EXP_COEFFS[c]));
+
+  __m128i biased = _mm_add_epi32(n, _mm_set1_epi32(1023));
+  __m256i wide = _mm256_cvtepu32_epi64(biased);
+  __m256d pow2n = _mm256_castsi256_pd(_mm256_slli_epi64(wide, 52));
+  return _mm256_mul_pd(p, pow2n);
+}
+
+// --- 3. SSE2 PATH (2 releases per step) ---
+void EvaluateLanesSSE2(const double *hype, const double *lifeTime,
+                       const double *decayTime, const double *qualityPower,
+                       const double *trendBonus, const double *viralBase,
+                       double *organicOut) {
+  // B. Freshness Curve
+  __m128d age = ExpSSE2(_mm_sub_pd(
+      _mm_setzero_pd(),
+      _mm_div_pd(_mm_loadu_pd(lifeTime), _mm_loadu_pd(decayTime))));
+
+  // D. Organic Discovery
+  __m128d organic =
+      _mm_mul_pd(_mm_loadu_pd(viralBase), _mm_loadu_pd(qualityPower));
+  organic = _mm_mul_pd(organic, _mm_loadu_pd(trendBonus));
+  organic = _mm_mul_pd(_mm_mul_pd(organic, age), _mm_loadu_pd(hype));
+  _mm_storeu_pd(organicOut, organic);
+}
+
+// --- 4. AVX2 PATH (4 releases per step) ---
+MUSICTYCOON_TARGET_AVX2 void
+EvaluateLanesAVX2(const double *hype, const double *lifeTime,
+                  const double *decayTime, const double *qualityPower,
+                  const double *trendBonus, const double *viralBase,
+                  double *organicOut) {
+  // B. Freshness Curve
+  __m256d age = ExpAVX2(_mm256_sub_pd(
+      _mm256_setzero_pd(),
+      _mm256_div_pd(_mm256_loadu_pd(lifeTime), _mm256_loadu_pd(decayTime))));
+
+  // D. Organic Discovery
+  __m256d organic =
+      _mm256_mul_pd(_mm256_loadu_pd(viralBase), _mm256_loadu_pd(qualityPower));
+  organic = _mm256_mul_pd(organic, _mm256_loadu_pd(trendBonus));
+  organic = _mm256_mul_pd(_mm256_mul_pd(organic, age), _mm256_loadu_pd(hype));
+  _mm256_storeu_pd(organicOut, organic);
+}
+
+// Runs 'Lanes' releases per step. lifeTime is widened to double on the
+// stack; the ragged tail is padded with harmless values so every release
+// goes through the same vector math.
+template <size_t Lanes, typename LaneFn>
+void EvaluateVector(const PerformanceBatch &batch, LaneFn lanes) {
+  size_t i = 0;
+  double life[Lanes];
+  for (; i + Lanes <= batch.count; i += Lanes) {
+    for (size_t l = 0; l < Lanes; ++l)
+      life[l] = batch.lifeTime[i + l];
+    lanes(batch.hype + i, life, batch.decayTime + i, batch.qualityPower + i,
+          batch.trendBonus + i, batch.viralBase + i, batch.organic + i);
+  }
+
+  size_t tail = batch.count - i;
+  if (tail == 0)
+    return;
+
+  double h[Lanes], d[Lanes], q[Lanes], t[Lanes], v[Lanes];
+  double outOrganic[Lanes];
+  for (size_t l = 0; l < Lanes; ++l) {
+    bool live = l < tail;
+    h[l] = live ? batch.hype[i + l] : 0.0;
+    life[l] = live ? batch.lifeTime[i + l] : 0.0;
+    d[l] = live ? batch.decayTime[i + l] : 1.0;
+    q[l] = live ? batch.qualityPower[i + l] : 0.0;
+    t[l] = live ? batch.trendBonus[i + l] : 1.0;
+    v[l] = live ? batch.viralBase[i + l] : 0.0;
+  }
+  lanes(h, life, d, q, t, v, outOrganic);
+  for (size_t l = 0; l < tail; ++l)
+    batch.organic[i + l] = outOrganic[l];
+}
+
+bool CpuHasAVX2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7)
+    return false;
+  __cpuid(info, 1);
+  bool osxsave = (info[2] & (1 << 27)) != 0;
+  bool avx = (info[2] & (1 << 28)) != 0;
+  if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+    return false;
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // MUSICTYCOON_X86_SIMD
+
+SimdLevel activeLevel = DetectSimdLevel();
+
+} // namespace
+
+SimdLevel DetectSimdLevel() {
+#ifdef MUSICTYCOON_X86_SIMD
+  static const SimdLevel detected =
+      CpuHasAVX2() ? SimdLevel::AVX2 : SimdLevel::SSE2;
+  return detected;
+#else
+  return SimdLevel::Scalar;
+#endif
+}
+
+SimdLevel GetSimdLevel() { return activeLevel; }
+
+void SetSimdLevel(SimdLevel level) {
+  activeLevel = std::min(level, DetectSimdLevel());
+}
+
+const char *SimdLevelName(SimdLevel level) {
+  switch (level) {
+  case SimdLevel::AVX2:
+    return "AVX2";
+  case SimdLevel::SSE2:
+    return "SSE2";
+  default:
+    return "Scalar";
+  }
+}
+
+void EvaluatePerformance(const PerformanceBatch &batch, SimdLevel level) {
+  level = std::min(level, DetectSimdLevel());
+
+#ifdef MUSICTYCOON_X86_SIMD
+  if (level == SimdLevel::AVX2) {
+    EvaluateVector<4>(batch, EvaluateLanesAVX2);
+    return;
+  }
+  if (level == SimdLevel::SSE2) {
+    EvaluateVector<2>(batch, EvaluateLanesSSE2);
+    return;
+  }
+#endif
+
+  EvaluateScalar(batch);
+}
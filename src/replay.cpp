@@ -0,0 +1,583 @@
+#include "../headers/replay.h"
+#include "../headers/config.h"
+#include "../headers/genre.h"
+#include "../headers/helper.h"
+#include "../headers/savegame.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+using namespace ReplayFormat;
+
+namespace {
+
+constexpr uint64_t Align8(uint64_t value) { return (value + 7) & ~uint64_t{7}; }
+
+// -------------------------------------------------------------------------
+// CHECKSUM
+// -------------------------------------------------------------------------
+
+// splitmix64 finalizer
+uint64_t Mix(uint64_t x) {
+  x ^= x >> 30;
+  x *= 0xBF58476D1CE4E5B9ull;
+  x ^= x >> 27;
+  x *= 0x94D049BB133111EBull;
+  return x ^ (x >> 31);
+}
+
+struct Hasher {
+  uint64_t state = 0x6D7479635265706Cull;
+
+  template <typename T> void Add(T value) {
+    uint64_t word;
+    if constexpr (std::is_enum_v<T>)
+      word = static_cast<uint64_t>(value);
+    else if constexpr (std::is_same_v<T, double>)
+      word = std::bit_cast<uint64_t>(value);
+    else if constexpr (std::is_same_v<T, float>)
+      word = std::bit_cast<uint32_t>(value);
+    else
+      word = static_cast<uint64_t>(value);
+    state = std::rotl(state ^ word, 27) * 0x9E3779B97F4A7C15ull;
+  }
+
+  template <typename T> void Add(const std::vector<T> &column) {
+    Add(column.size());
+    for (const T &value : column)
+      Add(value);
+  }
+};
+
+void AddCatalog(Hasher &hash, const ReleaseCatalog &catalog) {
+  hash.Add(catalog.id);
+  hash.Add(catalog.quality);
+  hash.Add(catalog.hype);
+  hash.Add(catalog.price);
+  hash.Add(catalog.lifeTime);
+  hash.Add(catalog.genre);
+  hash.Add(catalog.dailyStreams);
+  hash.Add(catalog.totalStreams);
+  hash.Add(catalog.totalSales);
+  hash.Add(catalog.earnings);
+  for (const ReleaseInfo &info : catalog.info) {
+    hash.Add(info.fansAtRelease);
+    hash.Add(info.tracks.size());
+  }
+}
+
+Genre ToGenre(uint8_t id) {
+  return id <= GenreIndex(Genre::Mixed) ? GenreAt(id) : Genre::Other;
+}
+
+bool IsAction(uint32_t command) {
+  return command <= static_cast<uint32_t>(SimCommandKind::FastForward) &&
+         command != static_cast<uint32_t>(SimCommandKind::Save) &&
+         command != static_cast<uint32_t>(SimCommandKind::Load);
+}
+
+} // namespace
+
+uint64_t WorldChecksum(const World &world) {
+  Hasher hash;
+
+  // 1. Player
+  const Player &player = world.player;
+  hash.Add(player.fans);
+  hash.Add(player.reputation);
+  hash.Add(player.money);
+  hash.Add(player.Energy);
+  hash.Add(player.repUpdateAccumulator);
+  for (double level : player.Skills())
+    hash.Add(level);
+  for (double level : player.Tools())
+    hash.Add(level);
+
+  // 2. Economy, market, clock and session stream
+  hash.Add(world.seed);
+  hash.Add(world.economy.seed);
+  hash.Add(world.economy.tick);
+  hash.Add(world.economy.accumulator);
+  hash.Add(world.economy.market.initialized);
+  hash.Add(world.economy.market.multiplier);
+  hash.Add(world.economy.market.genre);
+  hash.Add(world.economy.market.shiftCount);
+  hash.Add(*world.clock);
+  hash.Add(world.rng.Tell());
+
+  // 3. Vault (in recording order; dense order depends on past erases)
+  std::vector<uint32_t> order;
+  world.vault.InsertionOrder(order);
+  for (uint32_t i : order) {
+    const Song &song = world.vault.At(i);
+    hash.Add(song.genre);
+    hash.Add(song.price);
+    hash.Add(song.quality);
+    hash.Add(song.hype);
+    hash.Add(song.fansAtRelease);
+  }
+
+  // 4. Catalogs
+  AddCatalog(hash, world.songs);
+  AddCatalog(hash, world.albums);
+  return Mix(hash.state);
+}
+
+uint64_t RollChecksum(uint64_t rolling, uint64_t state) {
+  return Mix(rolling + 0x9E3779B97F4A7C15ull + state);
+}
+
+// -------------------------------------------------------------------------
+// RECORDING FILES
+// -------------------------------------------------------------------------
+
+static constexpr const char *RECORDING_PREFIX = "session-";
+static constexpr const char *RECORDING_EXTENSION = ".mtr";
+
+std::string RecordingDirectory() {
+  namespace fs = std::filesystem;
+  fs::path base;
+#ifdef _WIN32
+  if (const char *appData = std::getenv("APPDATA"))
+    base = appData;
+#else
+  if (const char *xdg = std::getenv("XDG_DATA_HOME"); xdg && *xdg)
+    base = xdg;
+  else if (const char *home = std::getenv("HOME"); home && *home)
+    base = fs::path(home) / ".local" / "share";
+#endif
+  if (base.empty())
+    return "recordings";
+  return (base / "MusicTycoon" / "recordings").string();
+}
+
+bool NextRecordingPath(const std::string &dir, size_t keep, std::string &path,
+                       std::string &error) {
+  namespace fs = std::filesystem;
+  std::error_code ec;
+  fs::create_directories(dir, ec);
+  if (ec) {
+    error = "Cannot create " + dir + ": " + ec.message();
+    return false;
+  }
+
+  // 1. Existing recordings; the timestamped names sort oldest first
+  std::vector<fs::path> existing;
+  for (const fs::directory_entry &entry : fs::directory_iterator(dir, ec)) {
+    const std::string name = entry.path().filename().string();
+    if (entry.is_regular_file(ec) && name.starts_with(RECORDING_PREFIX) &&
+        entry.path().extension() == RECORDING_EXTENSION)
+      existing.push_back(entry.path());
+  }
+  std::sort(existing.begin(), existing.end());
+
+  // 2. Name the new one after the local time; a session within the same
+  // second gets a suffix (_02, _03, ...: '_' sorts after '.') past the last
+  // one, so it still sorts after them
+  char stamp[32];
+  const std::time_t now = std::time(nullptr);
+  std::strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", std::localtime(&now));
+  const std::string stem = RECORDING_PREFIX + std::string(stamp);
+  std::string latest; // Newest recording from this second
+  for (const fs::path &recording : existing)
+    if (recording.filename().string().starts_with(stem))
+      latest = recording.filename().string();
+  fs::path candidate = fs::path(dir) / (stem + RECORDING_EXTENSION);
+  const auto taken = [&] {
+    return fs::exists(candidate, ec) ||
+           candidate.filename().string() <= latest;
+  };
+  char suffix[16];
+  for (int n = 2; n < 100 && taken(); ++n) {
+    std::snprintf(suffix, sizeof(suffix), "_%02d", n);
+    candidate = fs::path(dir) / (stem + suffix + RECORDING_EXTENSION);
+  }
+  if (fs::exists(candidate, ec)) {
+    error = "No free recording name in " + dir;
+    return false;
+  }
+
+  // 3. Make room for it (failures only leave an extra file)
+  const size_t kept = keep > 0 ? keep - 1 : 0;
+  for (size_t i = 0; i + kept < existing.size(); ++i)
+    fs::remove(existing[i], ec);
+
+  path = candidate.string();
+  return true;
+}
+
+// -------------------------------------------------------------------------
+// RECORDER
+// -------------------------------------------------------------------------
+
+InputRecorder::~InputRecorder() {
+  // Without Close() the recording has no End record and replays as cut
+  // short
+  if (file)
+    std::fclose(file);
+}
+
+bool InputRecorder::Open(const std::string &path, const World &world,
+                         std::string &error) {
+  if (file)
+    std::fclose(file);
+  ok = true;
+  steps = 0;
+  actions = 0;
+
+  file = std::fopen(path.c_str(), "wb");
+  if (!file) {
+    error = "Cannot open " + path + " for writing";
+    return false;
+  }
+
+  ReplayHeader header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.endianTag = ENDIAN_TAG;
+  header.seed = world.seed;
+  header.simdLevel = static_cast<uint8_t>(GetSimdLevel());
+  header.curveMode = static_cast<uint8_t>(GetCurveMode());
+  ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+
+  Snapshot(world);
+  if (!ok) {
+    std::fclose(file);
+    file = nullptr;
+    error = "Write error";
+    return false;
+  }
+  return true;
+}
+
+bool InputRecorder::Close(const World &world) {
+  if (!file)
+    return ok;
+
+  ReplayRecord record{};
+  record.step = steps;
+  record.tick = world.economy.tick;
+  record.kind = static_cast<uint32_t>(RecordKind::End);
+  record.checksum = WorldChecksum(world);
+  payload.clear();
+  Append(record);
+
+  ok = std::fclose(file) == 0 && ok;
+  file = nullptr;
+  return ok;
+}
+
+void InputRecorder::Note(const World &world, const SimCommand &command) {
+  if (!file || !IsAction(static_cast<uint32_t>(command.kind)))
+    return;
+
+  ReplayRecord record{};
+  record.step = steps;
+  record.tick = world.economy.tick;
+  record.kind = static_cast<uint32_t>(RecordKind::Action);
+  record.command = static_cast<uint32_t>(command.kind);
+  record.index = command.index;
+  record.cost = command.cost;
+  record.gain = command.gain;
+  record.amount = command.amount;
+  record.genre = static_cast<uint8_t>(GenreIndex(command.genre));
+  record.skill = command.skill ? 1 : 0;
+  record.song = NO_SONG;
+
+  // Payload: track numbers, then the text
+  payload.clear();
+  if (command.kind == SimCommandKind::ReleaseSingle ||
+      command.kind == SimCommandKind::ReleaseAlbum) {
+    record.song = SongNumber(world, command.song);
+    for (SlotHandle track : command.tracks) {
+      uint64_t number = SongNumber(world, track);
+      const auto *bytes = reinterpret_cast<const unsigned char *>(&number);
+      payload.insert(payload.end(), bytes, bytes + sizeof(number));
+    }
+    record.trackCount = static_cast<uint32_t>(command.tracks.size());
+  }
+  payload.insert(payload.end(), command.text.begin(), command.text.end());
+  record.textLength = static_cast<uint32_t>(command.text.size());
+  record.payloadSize = payload.size();
+
+  Append(record);
+  ++actions;
+}
+
+void InputRecorder::Snapshot(const World &world) {
+  if (!file)
+    return;
+
+  // The save's size is only known once it is written: write the record,
+  // the save, then go back and fill the size in
+  ReplayRecord record{};
+  record.step = steps;
+  record.tick = world.economy.tick;
+  record.kind = static_cast<uint32_t>(RecordKind::Snapshot);
+
+  // Songs are numbered relative to this snapshot from here on (the save
+  // writes the vault oldest first, i.e. in this order)
+  snapshotNext = world.vault.NextSequence();
+  snapshotSongs.clear();
+  for (size_t i = 0; i < world.vault.Size(); ++i)
+    snapshotSongs.push_back(world.vault.Sequence(world.vault.HandleAt(i)));
+  std::sort(snapshotSongs.begin(), snapshotSongs.end());
+
+  long start = std::ftell(file);
+  ok = ok && start >= 0 &&
+       std::fwrite(&record, sizeof(record), 1, file) == 1;
+
+  std::string error;
+  long saveStart = start + static_cast<long>(sizeof(record));
+  ok = ok && SaveWorld(world, file, error);
+  long end = std::ftell(file);
+  ok = ok && end >= saveStart;
+  if (!ok)
+    return;
+
+  record.payloadSize = static_cast<uint64_t>(end - saveStart);
+  static constexpr char zeros[8] = {};
+  size_t padding =
+      static_cast<size_t>(Align8(record.payloadSize) - record.payloadSize);
+  ok = std::fwrite(zeros, 1, padding, file) == padding &&
+       std::fseek(file, start, SEEK_SET) == 0 &&
+       std::fwrite(&record, sizeof(record), 1, file) == 1 &&
+       std::fseek(file, 0, SEEK_END) == 0 && std::fflush(file) == 0;
+}
+
+uint64_t InputRecorder::SongNumber(const World &world,
+                                  SlotHandle song) const {
+  uint64_t sequence = world.vault.Sequence(song);
+  if (sequence == SlotMap<Song>::NO_SEQUENCE)
+    return NO_SONG;
+
+  // Recorded since the snapshot: numbered in the same order on replay
+  if (sequence >= snapshotNext)
+    return snapshotSongs.size() + (sequence - snapshotNext);
+
+  // In the snapshot: its place in the save
+  auto it = std::lower_bound(snapshotSongs.begin(), snapshotSongs.end(),
+                             sequence);
+  return static_cast<uint64_t>(it - snapshotSongs.begin());
+}
+
+void InputRecorder::Append(const ReplayRecord &record) {
+  static constexpr char zeros[8] = {};
+  size_t size = payload.size();
+  size_t padding = static_cast<size_t>(Align8(size) - size);
+  ok = ok && std::fwrite(&record, sizeof(record), 1, file) == 1 &&
+       std::fwrite(payload.data(), 1, size, file) == size &&
+       std::fwrite(zeros, 1, padding, file) == padding &&
+       std::fflush(file) == 0; // A crash keeps everything up to here
+}
+
+// -------------------------------------------------------------------------
+// LOADING
+// -------------------------------------------------------------------------
+
+bool LoadRecording(const std::string &path, Recording &recording,
+                   std::string &error) {
+  std::FILE *in = std::fopen(path.c_str(), "rb");
+  if (!in) {
+    error = "Cannot open " + path;
+    return false;
+  }
+  std::vector<unsigned char> bytes;
+  unsigned char chunk[1 << 16];
+  size_t got;
+  while ((got = std::fread(chunk, 1, sizeof(chunk), in)) > 0)
+    bytes.insert(bytes.end(), chunk, chunk + got);
+  std::fclose(in);
+
+  // 1. Header
+  ReplayHeader header{};
+  if (bytes.size() < sizeof(header)) {
+    error = path + " is not a recording";
+    return false;
+  }
+  std::memcpy(&header, bytes.data(), sizeof(header));
+  if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+    error = path + " is not a recording";
+    return false;
+  }
+  if (header.endianTag != ENDIAN_TAG) {
+    error = "Recording was written on a machine with different byte order";
+    return false;
+  }
+  if (header.version != VERSION) {
+    error = header.version > VERSION ? "Recording is from a newer version"
+                                     : "Recording is from an older version";
+    return false;
+  }
+
+  recording = Recording{};
+  recording.seed = header.seed;
+  recording.simd = header.simdLevel <= static_cast<uint8_t>(SimdLevel::AVX2)
+                       ? static_cast<SimdLevel>(header.simdLevel)
+                       : SimdLevel::Scalar;
+  recording.curves = header.curveMode == static_cast<uint8_t>(CurveMode::Table)
+                         ? CurveMode::Table
+                         : CurveMode::Exact;
+
+  // 2. Records (a record cut off by a crash ends the recording)
+  uint64_t pos = sizeof(header);
+  while (pos + sizeof(ReplayRecord) <= bytes.size()) {
+    ReplayRecord record;
+    std::memcpy(&record, bytes.data() + pos, sizeof(record));
+    const unsigned char *data = bytes.data() + pos + sizeof(record);
+    uint64_t available = bytes.size() - pos - sizeof(record);
+    if (record.payloadSize > available)
+      break;
+    pos += sizeof(record) + Align8(record.payloadSize);
+
+    ReplayEvent event;
+    event.step = record.step;
+    event.tick = record.tick;
+    event.kind = static_cast<RecordKind>(record.kind);
+    switch (event.kind) {
+    case RecordKind::Snapshot:
+      event.save.assign(data, data + record.payloadSize);
+      break;
+
+    case RecordKind::Action: {
+      uint64_t numbers = uint64_t{record.trackCount} * sizeof(uint64_t);
+      if (!IsAction(record.command) ||
+          record.payloadSize != numbers + record.textLength) {
+        error = "Corrupt recording";
+        return false;
+      }
+      SimCommand &command = event.command;
+      command.kind = static_cast<SimCommandKind>(record.command);
+      command.genre = ToGenre(record.genre);
+      command.index = static_cast<size_t>(record.index);
+      command.skill = record.skill != 0;
+      command.cost = record.cost;
+      command.gain = record.gain;
+      command.amount = record.amount;
+      event.song = record.song;
+      event.tracks.resize(record.trackCount);
+      for (uint32_t t = 0; t < record.trackCount; ++t)
+        std::memcpy(&event.tracks[t], data + t * sizeof(uint64_t),
+                    sizeof(uint64_t));
+      command.text.assign(reinterpret_cast<const char *>(data + numbers),
+                          record.textLength);
+      break;
+    }
+
+    case RecordKind::End:
+      recording.complete = true;
+      recording.endStep = record.step;
+      recording.endTick = record.tick;
+      recording.checksum = record.checksum;
+      return true;
+
+    default:
+      error = "Corrupt recording";
+      return false;
+    }
+
+    if (recording.events.empty() && event.kind != RecordKind::Snapshot) {
+      error = "Recording does not start with a snapshot";
+      return false;
+    }
+    recording.events.push_back(std::move(event));
+  }
+
+  if (recording.events.empty()) {
+    error = "Recording is empty";
+    return false;
+  }
+  return true;
+}
+
+// -------------------------------------------------------------------------
+// REPLAY
+// -------------------------------------------------------------------------
+
+bool ReplaySession(const Recording &recording, World &world,
+                   const std::function<void(uint64_t, uint64_t)> &onStep,
+                   ReplayResult &result, std::string &error) {
+  constexpr float TICK = EconomyConfig::ECONOMY_TICK_RATE;
+  result = ReplayResult{};
+
+  // Recording and busking draw from the world's session stream, as on the
+  // simulation thread
+  Random::StreamScope scope(world.rng);
+
+  // Steps exactly as SimulationThread::Run does, then checks the economy
+  // is where it was when recorded
+  auto StepTo = [&](uint64_t step, uint64_t tick) {
+    while (result.steps < step) {
+      uint64_t before = world.economy.tick;
+      StepWorld(world, TICK);
+      result.ticks += world.economy.tick - before;
+      ++result.steps;
+      if (onStep) {
+        result.rolling = RollChecksum(result.rolling, WorldChecksum(world));
+        onStep(result.steps, result.rolling);
+      }
+    }
+    if (world.economy.tick != tick) {
+      error = "Replay diverged before step " + std::to_string(step) +
+              " (tick " + std::to_string(world.economy.tick) +
+              ", recorded " + std::to_string(tick) + ")";
+      return false;
+    }
+    return true;
+  };
+
+  uint64_t firstSong = 0; // Vault number of the last snapshot's song 0
+  SimCommand command;
+  for (const ReplayEvent &event : recording.events) {
+    if (event.step < result.steps) {
+      error = "Recording runs backwards at step " + std::to_string(event.step);
+      return false;
+    }
+
+    // A load replaces the world: no need to step the old one up to it
+    if (event.kind == RecordKind::Snapshot) {
+      result.steps = event.step;
+      if (!LoadWorld(world, event.save.data(), event.save.size(), error))
+        return false;
+      firstSong = world.vault.NextSequence() - world.vault.Size();
+      continue;
+    }
+
+    if (!StepTo(event.step, event.tick))
+      return false;
+
+    // Numbers back to handles in this vault
+    auto HandleOf = [&](uint64_t number) {
+      return number == NO_SONG ? SlotHandle{}
+                               : world.vault.Find(firstSong + number);
+    };
+    command = event.command;
+    command.song = HandleOf(event.song);
+    command.tracks.clear();
+    for (uint64_t number : event.tracks)
+      command.tracks.push_back(HandleOf(number));
+
+    uint64_t before = world.economy.tick;
+    ApplyAction(world, command);
+    result.ticks += world.economy.tick - before; // Fast-forwards
+    ++result.actions;
+  }
+
+  if (recording.complete && !StepTo(recording.endStep, recording.endTick))
+    return false;
+
+  result.checksum = WorldChecksum(world);
+  result.verified = recording.complete;
+  result.matches = recording.complete && result.checksum == recording.checksum;
+  return true;
+}
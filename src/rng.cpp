@@ -0,0 +1,72 @@
+#include "../headers/rng.h"
+
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+
+RandomStream::RandomStream(uint64_t seed, RngStream stream, uint64_t id,
+                           uint64_t tick) {
+  key = {static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)};
+
+  // Counter layout: [block index | tick low | id low | stream:8 tick:12 id:12]
+  uint32_t high = (static_cast<uint32_t>(stream) << 24) |
+                  (static_cast<uint32_t>((tick >> 32) & 0xFFF) << 12) |
+                  static_cast<uint32_t>((id >> 32) & 0xFFF);
+  counter = {0, static_cast<uint32_t>(tick), static_cast<uint32_t>(id), high};
+}
+
+uint64_t RandomStream::NextU64() {
+  if (hasSpare) {
+    hasSpare = false;
+    return spare;
+  }
+
+  Philox::Counter out = Philox::Block(counter, key);
+  ++counter[0];
+
+  spare = (static_cast<uint64_t>(out[3]) << 32) | out[2];
+  hasSpare = true;
+  return (static_cast<uint64_t>(out[1]) << 32) | out[0];
+}
+
+double RandomStream::NextDouble() {
+  return static_cast<double>(NextU64() >> 11) * 0x1.0p-53;
+}
+
+double RandomStream::Normal(double mean, double stdDev) {
+  // Box-Muller. u1 is in (0, 1] so the log is always finite.
+  double u1 = static_cast<double>((NextU64() >> 11) + 1) * 0x1.0p-53;
+  double u2 = NextDouble();
+  double radius = std::sqrt(-2.0 * std::log(u1));
+  return mean + stdDev * radius * std::cos(2.0 * std::numbers::pi * u2);
+}
+
+int RandomStream::Int(int min, int max) {
+  if (max <= min)
+    return min;
+
+  // Multiply-shift range reduction (bias < 2^-32, irrelevant here)
+  uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(max) - min) + 1;
+  uint64_t offset = ((NextU64() >> 32) * range) >> 32;
+  return static_cast<int>(min + static_cast<int64_t>(offset));
+}
+
+double RandomStream::Double(double min, double max) {
+  return min + (max - min) * NextDouble();
+}
+
+bool RandomStream::Chance(double probability01) {
+  return NextDouble() < probability01;
+}
+
+uint64_t RandomStream::Tell() const {
+  return static_cast<uint64_t>(counter[0]) * 2 - (hasSpare ? 1 : 0);
+}
+
+void RandomStream::Seek(uint64_t draws) {
+  // Each block yields two draws
+  counter[0] = static_cast<uint32_t>(draws / 2);
+  hasSpare = false;
+  if (draws % 2 != 0)
+    NextU64(); // Leaves the second half of the block as the spare
+}
@@ -0,0 +1,679 @@
+#include "../headers/savegame.h"
+#include "../headers/album.h"
+#include "../headers/catalog.h"
+#include "../headers/genre.h"
+#include "../headers/player.h"
+#include "../headers/rng.h"
+#include "../headers/song.h"
+#include "../headers/stringpool.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace SaveFormat;
+
+namespace {
+
+// Size of the header plus the section table; the first record array starts
+// right after it.
+constexpr uint64_t TABLE_END =
+    sizeof(SaveHeader) + SECTION_COUNT * sizeof(SaveSection);
+
+constexpr uint64_t Align8(uint64_t value) { return (value + 7) & ~uint64_t{7}; }
+
+// -------------------------------------------------------------------------
+// WRITER
+// -------------------------------------------------------------------------
+// Writes records straight to a buffered FILE as they are produced. Strings
+// are gathered into the table (written last) as they are referenced. The
+// save starts wherever the file is positioned; offsets count from there.
+class SaveWriter {
+public:
+  explicit SaveWriter(std::FILE *out) : file(out), base(std::ftell(out)) {
+    ok = base >= 0;
+  }
+
+  template <typename T> void Write(const T &record) {
+    ok = ok && std::fwrite(&record, sizeof(T), 1, file) == 1;
+    written += sizeof(T);
+  }
+
+  void PadTo(uint64_t offset) {
+    static constexpr char zeros[8] = {};
+    if (offset > written) {
+      size_t count = static_cast<size_t>(offset - written);
+      ok = ok && std::fwrite(zeros, 1, count, file) == count;
+      written = offset;
+    }
+  }
+
+  StringRef String(std::string_view text) {
+    // Every release carries the artist name; reuse the last one
+    if (text == lastText && !strings.empty())
+      return lastRef;
+
+    if (strings.size() + text.size() > UINT32_MAX) {
+      ok = false;
+      return {};
+    }
+    StringRef ref{static_cast<uint32_t>(strings.size()),
+                  static_cast<uint32_t>(text.size())};
+    strings.append(text);
+    lastText = text;
+    lastRef = ref;
+    return ref;
+  }
+
+  // Interned names: each distinct one is written once
+  StringRef String(StringId id) {
+    auto it = interned.find(id);
+    if (it != interned.end())
+      return it->second;
+    StringRef ref = String(stringPool.View(id));
+    interned.emplace(id, ref);
+    return ref;
+  }
+
+  void WriteStrings() {
+    ok = ok && std::fwrite(strings.data(), 1, strings.size(), file) ==
+                   strings.size();
+    written += strings.size();
+  }
+
+  // Rewrites the header and section table now that every size is known.
+  void Patch(const SaveHeader &header,
+             const std::array<SaveSection, SECTION_COUNT> &sections) {
+    const uint64_t end = written;
+    ok = ok && std::fseek(file, base, SEEK_SET) == 0;
+    Write(header);
+    for (const SaveSection &section : sections)
+      Write(section);
+    ok = ok && std::fseek(file, base + static_cast<long>(end), SEEK_SET) == 0;
+    written = end;
+  }
+
+  bool ok = true;
+  uint64_t written = 0;
+  std::string strings;
+
+private:
+  std::FILE *file;
+  long base; // File position of the header
+  std::string_view lastText;
+  StringRef lastRef;
+  std::unordered_map<StringId, StringRef> interned;
+};
+
+SongRecord MakeSongRecord(SaveWriter &writer, const Song &song) {
+  SongRecord record{};
+  record.name = writer.String(song.name);
+  record.artist = writer.String(song.artist);
+  record.price = song.price;
+  record.quality = song.quality;
+  record.hype = song.hype;
+  record.earnings = song.earnings;
+  record.fansAtRelease = song.fansAtRelease;
+  record.dailyStreams = song.dailyStreams;
+  record.totalStreams = song.totalStreams;
+  record.totalSales = song.totalSales;
+  record.lifeTime = song.lifeTime;
+  record.genre = static_cast<uint8_t>(song.genre);
+  return record;
+}
+
+ReleaseRecord MakeReleaseRecord(SaveWriter &writer,
+                                const ReleaseCatalog &catalog, size_t i,
+                                uint32_t firstTrack) {
+  const ReleaseInfo &info = catalog.info[i];
+  ReleaseRecord record{};
+  record.name = writer.String(info.name);
+  record.artist = writer.String(info.artist);
+  record.quality = catalog.quality[i];
+  record.hype = catalog.hype[i];
+  record.price = catalog.price[i];
+  record.earnings = catalog.earnings[i];
+  record.id = catalog.id[i];
+  record.dailyStreams = catalog.dailyStreams[i];
+  record.totalStreams = catalog.totalStreams[i];
+  record.totalSales = catalog.totalSales[i];
+  record.fansAtRelease = info.fansAtRelease;
+  record.lifeTime = catalog.lifeTime[i];
+  record.firstTrack = firstTrack;
+  record.trackCount = static_cast<uint32_t>(info.tracks.size());
+  record.genre = static_cast<uint8_t>(catalog.genre[i]);
+  return record;
+}
+
+// -------------------------------------------------------------------------
+// READER
+// -------------------------------------------------------------------------
+// Read-only mapping of a whole file.
+class MappedFile {
+public:
+  explicit MappedFile(const std::string &path) {
+#ifdef _WIN32
+    file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                       OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+      return;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+      return;
+    mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping)
+      return;
+    data = static_cast<const unsigned char *>(
+        MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (data)
+      size = static_cast<uint64_t>(fileSize.QuadPart);
+#else
+    fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      return;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0)
+      return;
+    void *view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ,
+                      MAP_PRIVATE, fd, 0);
+    if (view == MAP_FAILED)
+      return;
+    data = static_cast<const unsigned char *>(view);
+    size = static_cast<uint64_t>(info.st_size);
+#endif
+  }
+
+  ~MappedFile() {
+#ifdef _WIN32
+    if (data)
+      UnmapViewOfFile(data);
+    if (mapping)
+      CloseHandle(mapping);
+    if (file != INVALID_HANDLE_VALUE)
+      CloseHandle(file);
+#else
+    if (data)
+      munmap(const_cast<unsigned char *>(data), static_cast<size_t>(size));
+    if (fd >= 0)
+      close(fd);
+#endif
+  }
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  const unsigned char *data = nullptr;
+  uint64_t size = 0;
+
+private:
+#ifdef _WIN32
+  HANDLE file = INVALID_HANDLE_VALUE;
+  HANDLE mapping = nullptr;
+#else
+  int fd = -1;
+#endif
+};
+
+// One validated section: 'count' records, 'stride' bytes apart.
+struct SectionView {
+  const unsigned char *base = nullptr;
+  uint64_t count = 0;
+  uint64_t stride = 0;
+
+  // Copies out record i (memcpy: the mapping gives no alignment guarantee
+  // to the compiler, and older records may be shorter than T).
+  template <typename T> T Get(uint64_t i) const {
+    T record{};
+    std::memcpy(&record, base + i * stride,
+                static_cast<size_t>(std::min<uint64_t>(stride, sizeof(T))));
+    return record;
+  }
+};
+
+class SaveReader {
+public:
+  SaveReader(const unsigned char *bytes, uint64_t byteCount)
+      : data(bytes), size(byteCount) {}
+
+  bool Open(std::string &error) {
+    // 1. Header
+    if (size < TABLE_END) {
+      error = "File too small to be a save";
+      return false;
+    }
+    SaveHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+      error = "Not a Music Tycoon save";
+      return false;
+    }
+    if (header.endianTag != ENDIAN_TAG) {
+      error = "Save was written with a different byte order";
+      return false;
+    }
+    if (header.version > VERSION) {
+      error = "Save version " + std::to_string(header.version) +
+              " is newer than this build (" + std::to_string(VERSION) + ")";
+      return false;
+    }
+    if (header.fileSize != size ||
+        header.sectionCount > (size - sizeof(SaveHeader)) /
+                                  sizeof(SaveSection)) {
+      error = "Save file is truncated or corrupt";
+      return false;
+    }
+
+    // 2. Section table. Unknown kinds (from newer minor versions) are skipped.
+    const unsigned char *table = data + sizeof(SaveHeader);
+    for (uint32_t i = 0; i < header.sectionCount; ++i) {
+      SaveSection section;
+      std::memcpy(&section, table + i * sizeof(SaveSection), sizeof(section));
+      if (section.kind == 0 || section.kind > SECTION_COUNT)
+        continue;
+
+      if (section.recordSize == 0 || section.offset > size ||
+          section.count > (size - section.offset) / section.recordSize) {
+        error = "Save section out of bounds";
+        return false;
+      }
+      SectionView &view = sections[section.kind - 1];
+      view.base = data + section.offset;
+      view.count = section.count;
+      view.stride = section.recordSize;
+    }
+
+    if (Section(SectionKind::World).count != 1) {
+      error = "Save has no world record";
+      return false;
+    }
+    return true;
+  }
+
+  const SectionView &Section(SectionKind kind) const {
+    return sections[static_cast<uint32_t>(kind) - 1];
+  }
+
+  // Resolves a string reference; false if it points outside the table.
+  bool String(StringRef ref, std::string &out) const {
+    const SectionView &strings = Section(SectionKind::Strings);
+    if (static_cast<uint64_t>(ref.offset) + ref.length > strings.count)
+      return false;
+    out.assign(reinterpret_cast<const char *>(strings.base) + ref.offset,
+               ref.length);
+    return true;
+  }
+
+  // Same, interned straight from the mapped table.
+  bool String(StringRef ref, StringId &out) const {
+    const SectionView &strings = Section(SectionKind::Strings);
+    if (static_cast<uint64_t>(ref.offset) + ref.length > strings.count)
+      return false;
+    out = stringPool.Intern(std::string_view(
+        reinterpret_cast<const char *>(strings.base) + ref.offset,
+        ref.length));
+    return true;
+  }
+
+private:
+  const unsigned char *data;
+  uint64_t size;
+  std::array<SectionView, SECTION_COUNT> sections;
+};
+
+Genre ToGenre(uint8_t id) {
+  return id <= GenreIndex(Genre::Mixed) ? GenreAt(id) : Genre::Other;
+}
+
+bool ReadSong(const SaveReader &reader, const SongRecord &record, Song &out) {
+  StringId name, artist;
+  if (!reader.String(record.name, name) ||
+      !reader.String(record.artist, artist))
+    return false;
+
+  out = Song(name, artist, ToGenre(record.genre),
+             record.quality, record.fansAtRelease, record.price);
+  out.hype = record.hype;
+  out.earnings = record.earnings;
+  out.dailyStreams = record.dailyStreams;
+  out.totalStreams = record.totalStreams;
+  out.totalSales = record.totalSales;
+  out.lifeTime = record.lifeTime;
+  return true;
+}
+
+// Fills 'catalog' column by column from a ReleaseRecord array.
+bool ReadCatalog(const SaveReader &reader, SectionKind kind,
+                 ReleaseCatalog &catalog, std::string &error) {
+  const SectionView &releases = reader.Section(kind);
+  const SectionView &tracks = reader.Section(SectionKind::AlbumTracks);
+  catalog.Reserve(releases.count);
+
+  for (uint64_t i = 0; i < releases.count; ++i) {
+    ReleaseRecord record = releases.Get<ReleaseRecord>(i);
+
+    ReleaseInfo info;
+    info.fansAtRelease = record.fansAtRelease;
+    if (!reader.String(record.name, info.name) ||
+        !reader.String(record.artist, info.artist)) {
+      error = "Save string reference out of bounds";
+      return false;
+    }
+
+    if (catalog.isAlbum) {
+      if (static_cast<uint64_t>(record.firstTrack) + record.trackCount >
+          tracks.count) {
+        error = "Album track range out of bounds";
+        return false;
+      }
+      info.tracks.reserve(record.trackCount);
+      for (uint32_t t = 0; t < record.trackCount; ++t) {
+        Song track(StringId{0}, StringId{0}, Genre::Other, 0.0, 0, 0.0);
+        if (!ReadSong(reader, tracks.Get<SongRecord>(record.firstTrack + t),
+                      track)) {
+          error = "Save string reference out of bounds";
+          return false;
+        }
+        info.tracks.push_back(catalog.trackStore.Add(track));
+      }
+    }
+
+    catalog.id.push_back(record.id);
+    catalog.quality.push_back(record.quality);
+    catalog.hype.push_back(record.hype);
+    catalog.price.push_back(record.price);
+    catalog.lifeTime.push_back(record.lifeTime);
+    catalog.genre.push_back(ToGenre(record.genre));
+    catalog.dailyStreams.push_back(record.dailyStreams);
+    catalog.totalStreams.push_back(record.totalStreams);
+    catalog.totalSales.push_back(record.totalSales);
+    catalog.earnings.push_back(record.earnings);
+    catalog.info.push_back(std::move(info));
+  }
+  catalog.RebuildIndex();
+  return true;
+}
+
+// Hands each level record to 'set' as (id, level), matched by name.
+// Unknown names are skipped; levels missing from the save keep their
+// defaults.
+template <size_t N, typename Set>
+bool ReadLevels(const SaveReader &reader, SectionKind kind,
+                const std::array<std::string_view, N> &names, Set set) {
+  const SectionView &section = reader.Section(kind);
+  std::string name;
+  for (uint64_t i = 0; i < section.count; ++i) {
+    LevelRecord record = section.Get<LevelRecord>(i);
+    if (!reader.String(record.name, name))
+      return false;
+    auto it = std::find(names.begin(), names.end(), name);
+    if (it != names.end())
+      set(static_cast<size_t>(it - names.begin()), record.level);
+  }
+  return true;
+}
+
+} // namespace
+
+bool SaveWorld(const World &world, std::FILE *file, std::string &error) {
+  // 1. Section layout. Every count is known up front; only the string table
+  // size is patched in at the end.
+  uint64_t albumTrackCount = 0;
+  for (const ReleaseInfo &info : world.albums.info)
+    albumTrackCount += info.tracks.size();
+
+  std::array<SaveSection, SECTION_COUNT> sections{};
+  const std::array<std::pair<SectionKind, std::pair<uint32_t, uint64_t>>,
+                   SECTION_COUNT>
+      layout = {{
+          {SectionKind::World, {sizeof(WorldRecord), 1}},
+          {SectionKind::Skills, {sizeof(LevelRecord), SKILL_COUNT}},
+          {SectionKind::Tools, {sizeof(LevelRecord), TOOL_COUNT}},
+          {SectionKind::Vault, {sizeof(SongRecord), world.vault.Size()}},
+          {SectionKind::Songs, {sizeof(ReleaseRecord), world.songs.Size()}},
+          {SectionKind::Albums, {sizeof(ReleaseRecord), world.albums.Size()}},
+          {SectionKind::AlbumTracks, {sizeof(SongRecord), albumTrackCount}},
+          {SectionKind::Strings, {1, 0}},
+      }};
+
+  uint64_t offset = TABLE_END;
+  for (size_t i = 0; i < SECTION_COUNT; ++i) {
+    auto [kind, shape] = layout[i];
+    sections[i] = {static_cast<uint32_t>(kind), shape.first, offset,
+                   shape.second};
+    offset = Align8(offset + shape.first * shape.second);
+  }
+
+  SaveHeader header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.endianTag = ENDIAN_TAG;
+  header.sectionCount = SECTION_COUNT;
+
+  SaveWriter writer(file);
+  writer.Write(header);
+  for (const SaveSection &section : sections)
+    writer.Write(section);
+
+  // 2. World
+  const Player &player = world.player;
+  WorldRecord worldRecord{};
+  worldRecord.seed = world.seed;
+  worldRecord.rngPosition = world.rng.Tell();
+  worldRecord.economySeed = world.economy.seed;
+  worldRecord.economyTick = world.economy.tick;
+  worldRecord.marketShiftCount = world.economy.market.shiftCount;
+  worldRecord.money = player.money;
+  worldRecord.reputation = player.reputation;
+  worldRecord.energy = player.Energy;
+  worldRecord.playerName = writer.String(player.name);
+  worldRecord.fans = player.fans;
+  worldRecord.repUpdateAccumulator = player.repUpdateAccumulator;
+  worldRecord.clock = world.clock ? *world.clock : 0.0f;
+  worldRecord.economyAccumulator = world.economy.accumulator;
+  worldRecord.marketMultiplier = world.economy.market.multiplier;
+  worldRecord.songsNextId = world.songs.nextId;
+  worldRecord.albumsNextId = world.albums.nextId;
+  worldRecord.marketInitialized = world.economy.market.initialized ? 1 : 0;
+  worldRecord.marketGenre = static_cast<uint8_t>(world.economy.market.genre);
+  worldRecord.tickMode = static_cast<uint8_t>(world.mode);
+  writer.PadTo(sections[0].offset);
+  writer.Write(worldRecord);
+
+  // 3. Player levels, vault, catalogs and album tracks
+  writer.PadTo(sections[1].offset);
+  for (size_t i = 0; i < SKILL_COUNT; ++i) {
+    writer.Write(
+        LevelRecord{writer.String(SKILL_NAMES[i]), player.Skills()[i]});
+  }
+
+  writer.PadTo(sections[2].offset);
+  for (size_t i = 0; i < TOOL_COUNT; ++i)
+    writer.Write(LevelRecord{writer.String(TOOL_NAMES[i]), player.Tools()[i]});
+
+  writer.PadTo(sections[3].offset);
+  std::vector<uint32_t> vaultOrder; // Recording order
+  world.vault.InsertionOrder(vaultOrder);
+  for (uint32_t i : vaultOrder)
+    writer.Write(MakeSongRecord(writer, world.vault.At(i)));
+
+  writer.PadTo(sections[4].offset);
+  for (size_t i = 0; i < world.songs.Size(); ++i)
+    writer.Write(MakeReleaseRecord(writer, world.songs, i, 0));
+
+  writer.PadTo(sections[5].offset);
+  uint32_t firstTrack = 0;
+  for (size_t i = 0; i < world.albums.Size(); ++i) {
+    writer.Write(MakeReleaseRecord(writer, world.albums, i, firstTrack));
+    firstTrack += static_cast<uint32_t>(world.albums.info[i].tracks.size());
+  }
+
+  writer.PadTo(sections[6].offset);
+  for (const ReleaseInfo &info : world.albums.info) {
+    for (SongId track : info.tracks)
+      writer.Write(MakeSongRecord(writer, world.albums.trackStore[track]));
+  }
+
+  // 4. String table, then patch its size and the file size into the header
+  writer.PadTo(sections[7].offset);
+  writer.WriteStrings();
+  sections[7].count = writer.strings.size();
+  header.fileSize = writer.written;
+  writer.Patch(header, sections);
+  if (!writer.ok)
+    error = "Write error";
+  return writer.ok;
+}
+
+bool SaveWorld(const World &world, const std::string &path,
+               std::string &error) {
+  const std::string tempPath = path + ".tmp";
+  std::FILE *file = std::fopen(tempPath.c_str(), "wb");
+  if (!file) {
+    error = "Cannot open " + tempPath + " for writing";
+    return false;
+  }
+  std::setvbuf(file, nullptr, _IOFBF, 1 << 20);
+
+  bool ok = SaveWorld(world, file, error);
+  ok = std::fclose(file) == 0 && ok;
+  if (!ok) {
+    std::remove(tempPath.c_str());
+    error = "Failed writing " + tempPath;
+    return false;
+  }
+
+  // 5. Swap the finished file into place
+  std::error_code ec;
+  std::filesystem::rename(tempPath, path, ec);
+  if (ec) {
+    // Windows will not rename over an existing file
+    std::filesystem::remove(path, ec);
+    std::filesystem::rename(tempPath, path, ec);
+  }
+  if (ec) {
+    error = "Cannot replace " + path + ": " + ec.message();
+    return false;
+  }
+  return true;
+}
+
+bool LoadWorld(World &world, const std::string &path, std::string &error) {
+  MappedFile file(path);
+  if (!file.data) {
+    error = "Cannot open " + path;
+    return false;
+  }
+  return LoadWorld(world, file.data, file.size, error);
+}
+
+bool LoadWorld(World &world, const unsigned char *data, uint64_t size,
+               std::string &error) {
+  SaveReader reader(data, size);
+  if (!reader.Open(error))
+    return false;
+
+  // 1. World record
+  WorldRecord record = reader.Section(SectionKind::World).Get<WorldRecord>(0);
+  std::string playerName;
+  if (!reader.String(record.playerName, playerName)) {
+    error = "Save string reference out of bounds";
+    return false;
+  }
+
+  World loaded(record.seed, std::move(playerName));
+  loaded.rng.Seek(record.rngPosition);
+  loaded.economy.seed = record.economySeed;
+  loaded.economy.tick = record.economyTick;
+  loaded.economy.accumulator = record.economyAccumulator;
+  loaded.economy.market.initialized = record.marketInitialized != 0;
+  loaded.economy.market.multiplier = record.marketMultiplier;
+  loaded.economy.market.genre = ToGenre(record.marketGenre);
+  loaded.economy.market.shiftCount = record.marketShiftCount;
+  loaded.mode = record.tickMode == static_cast<uint8_t>(TickMode::Parallel)
+                    ? TickMode::Parallel
+                    : TickMode::Serial;
+
+  Player &player = loaded.player;
+  player.money = record.money;
+  player.reputation = record.reputation;
+  player.Energy = record.energy;
+  player.fans = record.fans;
+  player.repUpdateAccumulator = record.repUpdateAccumulator;
+
+  // 2. Player levels and vault
+  auto SetSkill = [&](size_t i, double level) {
+    player.SetSkillLevel(static_cast<Skill>(i), level);
+  };
+  auto SetTool = [&](size_t i, double level) {
+    player.SetToolLevel(static_cast<Tool>(i), level);
+  };
+  if (!ReadLevels(reader, SectionKind::Skills, SKILL_NAMES, SetSkill) ||
+      !ReadLevels(reader, SectionKind::Tools, TOOL_NAMES, SetTool)) {
+    error = "Save string reference out of bounds";
+    return false;
+  }
+
+  // Vault songs go into the world's own vault on commit (see 4.)
+  const SectionView &vault = reader.Section(SectionKind::Vault);
+  std::vector<Song> vaultSongs;
+  vaultSongs.reserve(vault.count);
+  for (uint64_t i = 0; i < vault.count; ++i) {
+    Song song(StringId{0}, StringId{0}, Genre::Other, 0.0, 0, 0.0);
+    if (!ReadSong(reader, vault.Get<SongRecord>(i), song)) {
+      error = "Save string reference out of bounds";
+      return false;
+    }
+    vaultSongs.push_back(song);
+  }
+
+  // 3. Catalogs
+  if (!ReadCatalog(reader, SectionKind::Songs, loaded.songs, error) ||
+      !ReadCatalog(reader, SectionKind::Albums, loaded.albums, error))
+    return false;
+  loaded.songs.nextId = record.songsNextId;
+  loaded.albums.nextId = record.albumsNextId;
+
+  // 4. Commit. The clock object is shared with the UI, so keep it; so are
+  // the attached log and telemetry recorder. The vault keeps its slot
+  // table: handles to songs from before the load must never resolve to a
+  // loaded one.
+  std::shared_ptr<float> clock = world.clock;
+  EventLog *log = world.log;
+  TelemetryRecorder *telemetry = world.economy.telemetry;
+  SlotMap<Song> slots = std::move(world.vault);
+  world = std::move(loaded);
+  slots.Clear();
+  slots.Reserve(vaultSongs.size());
+  for (const Song &song : vaultSongs)
+    slots.Insert(song);
+  world.vault = std::move(slots);
+  if (clock) {
+    *clock = record.clock;
+    world.clock = std::move(clock);
+  } else {
+    *world.clock = record.clock;
+  }
+  world.log = log;
+  world.economy.telemetry = telemetry;
+  return true;
+}
@@ -0,0 +1,642 @@
+// Headless batch runner for the economy model.
+// Runs N economy ticks back-to-back (no render window, no frame limit) and
+// prints the final player and catalog stats. Used for balancing and
+// regression runs that need simulated years of career in seconds.
+
+#include "../headers/Simulation.h"
+#include "../headers/album.h"
+#include "../headers/catalog.h"
+#include "../headers/config.h"
+#include "../headers/curves.h"
+#include "../headers/eventlog.h"
+#include "../headers/helper.h"
+#include "../headers/montecarlo.h"
+#include "../headers/performance.h"
+#include "../headers/savegame.h"
+#include "../headers/player.h"
+#include "../headers/replay.h"
+#include "../headers/song.h"
+#include "../headers/telemetry.h"
+#include "../headers/threadpool.h"
+#include "../headers/world.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct SimOptions {
+  long long ticks = 10000;
+  int songs = 10;         // Singles in the starting catalog
+  int albums = 0;         // Albums in the starting catalog
+  int tracksPerAlbum = 10;
+  int releaseEvery = 0;   // Release a new single every N ticks (0 = never)
+  double quality = -1.0;  // Fixed release quality (< 0 = roll via CalcQuality)
+  int fans = 100;
+  double money = 50.0;
+  uint64_t seed = Random::DEFAULT_SEED;
+  SimdLevel simd = DetectSimdLevel();
+  CurveMode curves = GetCurveMode();
+  bool checkKernel = false; // Compare SIMD kernel paths against scalar
+  TickMode mode = TickMode::Serial;
+  bool fastForward = false; // Skip idle stretches analytically
+  long long careers = 0;  // > 0 = Monte Carlo mode
+  int bins = 20;          // Histogram bins in Monte Carlo mode
+  std::string loadPath;   // Continue from this save instead of a new career
+  std::string savePath;   // Save the world here after the run
+  std::string telemetryPath; // Record one row per tick here
+  std::string dumpPath;      // Print this telemetry file as CSV and exit
+  std::string replayPath;    // Replay this recorded session and exit
+  std::string checksumPath;  // Replay: write the per-step checksums here
+};
+
+void PrintUsage(const char *exe) {
+  std::printf(
+      "Usage: %s [options]\n"
+      "  --ticks N          economy ticks to simulate (default 10000)\n"
+      "  --songs N          singles in the starting catalog (default 10)\n"
+      "  --albums N         albums in the starting catalog (default 0)\n"
+      "  --tracks N         tracks per starting album (default 10)\n"
+      "  --release-every N  release a new single every N ticks (default 0)\n"
+      "  --quality Q        fixed release quality 1-100 (default: rolled)\n"
+      "  --fans N           starting fans (default 100)\n"
+      "  --money X          starting money (default 50)\n"
+      "  --seed N           RNG seed; same seed = same run (default fixed)\n"
+      "  --simd LEVEL       scalar | sse2 | avx2 (default: best available)\n"
+      "  --curves MODE      table | exact quality curves (default table;\n"
+      "                     exact reproduces the original math)\n"
+      "  --check-kernel     verify SIMD kernel and curve tables against\n"
+      "                     the exact math\n"
+      "  --parallel         multi-threaded tick (per-chunk reductions)\n"
+      "  --fast-forward     skip idle stretches analytically (same\n"
+      "                     distribution, not the same numbers)\n"
+      "  --careers N        Monte Carlo: run N independent careers across\n"
+      "                     all cores and report outcome distributions\n"
+      "  --bins N           histogram bins in Monte Carlo mode (default 20)\n"
+      "  --load PATH        continue the career stored in a save file\n"
+      "  --save PATH        write the final world to a save file\n"
+      "  --telemetry PATH   record per-tick telemetry (columnar file)\n"
+      "  --dump PATH        print a telemetry file as CSV and exit\n"
+      "  --replay PATH      re-run a recorded play session (session-*.mtr)\n"
+      "                     and check it ends in the recorded state\n"
+      "  --checksums PATH   with --replay: write step,rolling checksum CSV\n",
+      exe);
+}
+
+bool ParseArgs(int argc, char **argv, SimOptions &opt) {
+  for (int i = 1; i < argc; ++i) {
+    const char *arg = argv[i];
+    if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0)
+      return false;
+    if (std::strcmp(arg, "--check-kernel") == 0) {
+      opt.checkKernel = true;
+      continue;
+    }
+    if (std::strcmp(arg, "--parallel") == 0) {
+      opt.mode = TickMode::Parallel;
+      continue;
+    }
+    if (std::strcmp(arg, "--fast-forward") == 0) {
+      opt.fastForward = true;
+      continue;
+    }
+
+    // Every remaining option takes exactly one value
+    if (i + 1 >= argc) {
+      std::fprintf(stderr, "Missing value for %s\n", arg);
+      return false;
+    }
+    const char *value = argv[++i];
+
+    if (std::strcmp(arg, "--ticks") == 0)
+      opt.ticks = std::atoll(value);
+    else if (std::strcmp(arg, "--songs") == 0)
+      opt.songs = std::atoi(value);
+    else if (std::strcmp(arg, "--albums") == 0)
+      opt.albums = std::atoi(value);
+    else if (std::strcmp(arg, "--tracks") == 0)
+      opt.tracksPerAlbum = std::max(1, std::atoi(value));
+    else if (std::strcmp(arg, "--release-every") == 0)
+      opt.releaseEvery = std::atoi(value);
+    else if (std::strcmp(arg, "--quality") == 0)
+      opt.quality = std::atof(value);
+    else if (std::strcmp(arg, "--fans") == 0)
+      opt.fans = std::atoi(value);
+    else if (std::strcmp(arg, "--money") == 0)
+      opt.money = std::atof(value);
+    else if (std::strcmp(arg, "--careers") == 0)
+      opt.careers = std::atoll(value);
+    else if (std::strcmp(arg, "--bins") == 0)
+      opt.bins = std::max(1, std::atoi(value));
+    else if (std::strcmp(arg, "--load") == 0)
+      opt.loadPath = value;
+    else if (std::strcmp(arg, "--save") == 0)
+      opt.savePath = value;
+    else if (std::strcmp(arg, "--telemetry") == 0)
+      opt.telemetryPath = value;
+    else if (std::strcmp(arg, "--dump") == 0)
+      opt.dumpPath = value;
+    else if (std::strcmp(arg, "--replay") == 0)
+      opt.replayPath = value;
+    else if (std::strcmp(arg, "--checksums") == 0)
+      opt.checksumPath = value;
+    else if (std::strcmp(arg, "--seed") == 0)
+      opt.seed = std::strtoull(value, nullptr, 0);
+    else if (std::strcmp(arg, "--simd") == 0) {
+      if (std::strcmp(value, "scalar") == 0)
+        opt.simd = SimdLevel::Scalar;
+      else if (std::strcmp(value, "sse2") == 0)
+        opt.simd = SimdLevel::SSE2;
+      else if (std::strcmp(value, "avx2") == 0)
+        opt.simd = SimdLevel::AVX2;
+      else {
+        std::fprintf(stderr, "Unknown SIMD level: %s\n", value);
+        return false;
+      }
+    } else if (std::strcmp(arg, "--curves") == 0) {
+      if (std::strcmp(value, "table") == 0)
+        opt.curves = CurveMode::Table;
+      else if (std::strcmp(value, "exact") == 0)
+        opt.curves = CurveMode::Exact;
+      else {
+        std::fprintf(stderr, "Unknown curve mode: %s\n", value);
+        return false;
+      }
+    } else {
+      std::fprintf(stderr, "Unknown option: %s\n", arg);
+      return false;
+    }
+  }
+  return true;
+}
+
+double RollQuality(const Player &player, const SimOptions &opt) {
+  if (opt.quality > 0.0)
+    return std::clamp(opt.quality, 1.0, 100.0);
+  return player.CalcQuality();
+}
+
+Song MakeSingle(const Player &player, const SimOptions &opt) {
+  double quality = RollQuality(player, opt);
+  return Song(GenerateSongName(), player.name, Genre::Pop, quality, player.fans,
+              GetRecommendedPrice(quality, false));
+}
+
+// Sweeps each curve table densely and reports its worst relative deviation
+// from std::pow / std::exp.
+bool CheckCurves() {
+  constexpr int SAMPLES = 1000000;
+  bool passed = true;
+  auto Sweep = [&](const char *name, double lo, double hi, auto table,
+                   auto exact) {
+    double worst = 0.0;
+    for (int i = 0; i <= SAMPLES; ++i) {
+      double x = lo + (hi - lo) * i / SAMPLES;
+      double ref = exact(x);
+      double scale = std::max(std::fabs(ref), 1e-300);
+      worst = std::max(worst, std::fabs(table(x) - ref) / scale);
+    }
+    bool ok = worst <= CURVE_TABLE_TOLERANCE;
+    passed = passed && ok;
+    std::printf("curve  %-10s max rel error %.3e (tolerance %.0e) %s\n", name,
+                worst, CURVE_TABLE_TOLERANCE, ok ? "OK" : "FAIL");
+  };
+
+  Sweep(
+      "discovery", EconomyConfig::MIN_QUALITY, EconomyConfig::MAX_QUALITY,
+      [](double q) { return DiscoveryCurve(q, CurveMode::Table); },
+      [](double q) { return DiscoveryCurve(q, CurveMode::Exact); });
+  Sweep(
+      "conversion", EconomyConfig::CONVERSION_MIN_QUALITY,
+      EconomyConfig::MAX_QUALITY,
+      [](double q) { return ConversionCurve(q, CurveMode::Table); },
+      [](double q) { return ConversionCurve(q, CurveMode::Exact); });
+  Sweep(
+      "freshness", 0.0, FRESHNESS_MAX_AGE,
+      [](double age) { return FreshnessCurve(age, CurveMode::Table); },
+      [](double age) { return FreshnessCurve(age, CurveMode::Exact); });
+  return passed;
+}
+
+// A quiet career (a few mid-quality singles, a small fanbase) skipping a
+// week, as the Skip Week button does: the 7 ticks must be one analytic span.
+bool CheckFastForward() {
+  constexpr uint64_t WEEK = 7;
+  constexpr float TICK = EconomyConfig::ECONOMY_TICK_RATE;
+  World world(Random::DEFAULT_SEED);
+  Random::StreamScope scope(world.rng);
+  world.player.fans = 300;
+  for (int i = 0; i < 20; ++i) {
+    world.songs.Add(Song("Check Song", world.player.name, Genre::Pop, 30.0,
+                         world.player.fans, GetRecommendedPrice(30.0, false)));
+  }
+
+  // Settle the launch spike, then start right after a market shift (the
+  // clock winds back), so the week is clear of the next one
+  for (int t = 0; t < 200; ++t)
+    StepWorld(world, TICK);
+  for (float before = *world.clock; *world.clock >= before;) {
+    before = *world.clock;
+    StepWorld(world, TICK);
+  }
+
+  uint64_t tick = world.economy.tick;
+  uint64_t span =
+      FastForwardEconomy(world.economy, world.songs, world.albums,
+                         world.player, WEEK, *world.clock);
+  bool ok = span == WEEK && world.economy.tick == tick + WEEK;
+  std::printf("fast-forward week: %llu of %llu ticks in one span %s\n",
+              static_cast<unsigned long long>(span),
+              static_cast<unsigned long long>(WEEK), ok ? "OK" : "FAIL");
+  return ok;
+}
+
+// Runs random release blocks through every supported kernel path and
+// reports the worst relative deviation from the scalar reference (exact
+// curves), then checks the curve tables.
+bool CheckKernel() {
+  constexpr size_t SAMPLES = 100000;
+  std::vector<double> decayTime(SAMPLES), qualityPower(SAMPLES);
+  std::vector<double> hype(SAMPLES), trend(SAMPLES), viral(SAMPLES);
+  std::vector<float> life(SAMPLES);
+
+  bool passed = true;
+  for (bool isAlbum : {false, true}) {
+    for (size_t i = 0; i < SAMPLES; ++i) {
+      double quality = Random::Double(1.0, 100.0);
+      double price = GetRecommendedPrice(quality, isAlbum) *
+                     Random::Double(0.2, 3.0);
+      PerformanceCurve curve =
+          EvaluatePerformanceCurve(quality, price, isAlbum, CurveMode::Exact);
+      decayTime[i] = curve.decayTime;
+      qualityPower[i] = curve.qualityPower;
+      hype[i] = Random::Double(0.0, 10.0);
+      life[i] = static_cast<float>(Random::Double(0.0, 500.0));
+      trend[i] = Random::Chance(0.2) ? Random::Double(1.1, 2.0) : 1.0;
+      viral[i] = Random::Normal(isAlbum ? 150.0 : 50.0, 15.0);
+    }
+
+    auto Run = [&](SimdLevel level, std::vector<double> &organic) {
+      organic.resize(SAMPLES);
+      PerformanceBatch batch;
+      batch.count = SAMPLES;
+      batch.hype = hype.data();
+      batch.lifeTime = life.data();
+      batch.decayTime = decayTime.data();
+      batch.qualityPower = qualityPower.data();
+      batch.trendBonus = trend.data();
+      batch.viralBase = viral.data();
+      batch.organic = organic.data();
+      EvaluatePerformance(batch, level);
+    };
+
+    std::vector<double> refOrganic;
+    Run(SimdLevel::Scalar, refOrganic);
+
+    for (SimdLevel level : {SimdLevel::SSE2, SimdLevel::AVX2}) {
+      if (level > DetectSimdLevel())
+        continue;
+
+      std::vector<double> organic;
+      Run(level, organic);
+
+      double worst = 0.0;
+      for (size_t i = 0; i < SAMPLES; ++i) {
+        double scale = std::max(std::fabs(refOrganic[i]), 1e-300);
+        worst = std::max(worst, std::fabs(organic[i] - refOrganic[i]) / scale);
+      }
+
+      bool ok = worst <= PERFORMANCE_KERNEL_TOLERANCE;
+      passed = passed && ok;
+      std::printf("%-6s %-6s max rel error %.3e (tolerance %.0e) %s\n",
+                  isAlbum ? "album" : "single", SimdLevelName(level), worst,
+                  PERFORMANCE_KERNEL_TOLERANCE, ok ? "OK" : "FAIL");
+    }
+  }
+  bool curves = CheckCurves();
+  bool fastForward = CheckFastForward();
+  return curves && fastForward && passed;
+}
+
+void PrintDistribution(const char *label, const Distribution &dist) {
+  std::printf("%-11s mean %.2f  sd %.2f  min %.2f  max %.2f\n", label,
+              dist.mean, dist.stdDev, dist.min, dist.max);
+  std::printf("%-11s", "");
+  for (size_t p = 0; p < Distribution::PERCENTILES.size(); ++p) {
+    std::printf(" p%g %.2f", Distribution::PERCENTILES[p],
+                dist.percentiles[p]);
+  }
+  std::printf("\n");
+
+  size_t peak = 1;
+  for (size_t count : dist.histogram)
+    peak = std::max(peak, count);
+  for (size_t bin = 0; bin < dist.histogram.size(); ++bin) {
+    double from = dist.min + bin * dist.binWidth;
+    int bar = static_cast<int>(40 * dist.histogram[bin] / peak);
+    std::printf("  %14.2f | %-40.*s %zu\n", from, bar,
+                "########################################",
+                dist.histogram[bin]);
+  }
+}
+
+int RunCareers(const SimOptions &opt) {
+  CareerPlan plan;
+  plan.ticks = opt.ticks;
+  plan.releaseEvery = opt.releaseEvery;
+  plan.quality = opt.quality;
+  plan.startingSongs = opt.songs;
+  plan.fans = opt.fans;
+  plan.money = opt.money;
+
+  MonteCarloReport report = RunMonteCarlo(
+      plan, static_cast<size_t>(opt.careers), opt.seed, opt.bins);
+
+  std::printf("--- Monte Carlo ---\n");
+  std::printf("Careers:           %lld x %lld ticks\n", opt.careers,
+              opt.ticks);
+  std::printf("Wall time:         %.3f s (%.0f careers/s, %zu threads)\n",
+              report.wallSeconds,
+              report.wallSeconds > 0.0 ? opt.careers / report.wallSeconds
+                                       : 0.0,
+              SharedThreadPool().Size());
+  std::printf("Kernel:            %s\n", SimdLevelName(GetSimdLevel()));
+  std::printf("Curves:            %s\n", CurveModeName(GetCurveMode()));
+  std::printf("Seed:              %llu\n",
+              static_cast<unsigned long long>(opt.seed));
+  PrintDistribution("Money", report.money);
+  PrintDistribution("Fans", report.fans);
+  PrintDistribution("Reputation", report.reputation);
+  return 0;
+}
+
+int RunReplay(const SimOptions &opt) {
+  Recording recording;
+  std::string error;
+  if (!LoadRecording(opt.replayPath, recording, error)) {
+    std::fprintf(stderr, "Replay: %s\n", error.c_str());
+    return 1;
+  }
+
+  // The session ran with these; other kernels or curves round differently
+  SetSimdLevel(recording.simd);
+  SetCurveMode(recording.curves);
+  if (GetSimdLevel() != recording.simd)
+    std::fprintf(stderr,
+                 "Recorded with the %s kernel, replaying with %s: the run "
+                 "may diverge\n",
+                 SimdLevelName(recording.simd), SimdLevelName(GetSimdLevel()));
+
+  std::FILE *csv = nullptr;
+  std::function<void(uint64_t, uint64_t)> onStep;
+  if (!opt.checksumPath.empty()) {
+    csv = std::fopen(opt.checksumPath.c_str(), "w");
+    if (!csv) {
+      std::fprintf(stderr, "Cannot open %s for writing\n",
+                   opt.checksumPath.c_str());
+      return 1;
+    }
+    std::fprintf(csv, "step,checksum\n");
+    onStep = [csv](uint64_t step, uint64_t rolling) {
+      std::fprintf(csv, "%llu,%016llx\n",
+                   static_cast<unsigned long long>(step),
+                   static_cast<unsigned long long>(rolling));
+    };
+  }
+
+  World world(recording.seed);
+  ReplayResult result;
+  auto start = std::chrono::steady_clock::now();
+  bool ok = ReplaySession(recording, world, onStep, result, error);
+  std::chrono::duration<double> wall = std::chrono::steady_clock::now() - start;
+  if (csv)
+    std::fclose(csv);
+  if (!ok) {
+    std::fprintf(stderr, "Replay: %s\n", error.c_str());
+    return 1;
+  }
+
+  double wallSeconds = wall.count();
+  std::printf("--- Replay ---\n");
+  std::printf("Recording:         %s (%zu events%s)\n",
+              opt.replayPath.c_str(), recording.events.size(),
+              recording.complete ? "" : ", cut short");
+  std::printf("Steps:             %llu (%llu economy ticks)\n",
+              static_cast<unsigned long long>(result.steps),
+              static_cast<unsigned long long>(result.ticks));
+  std::printf("Actions:           %llu\n",
+              static_cast<unsigned long long>(result.actions));
+  std::printf("Wall time:         %.3f s (%.0f steps/s)\n", wallSeconds,
+              wallSeconds > 0.0 ? result.steps / wallSeconds : 0.0);
+  std::printf("Kernel:            %s\n", SimdLevelName(GetSimdLevel()));
+  std::printf("Curves:            %s\n", CurveModeName(GetCurveMode()));
+  std::printf("Seed:              %llu\n",
+              static_cast<unsigned long long>(recording.seed));
+  std::printf("Checksum:          %016llx (%s)\n",
+              static_cast<unsigned long long>(result.checksum),
+              !result.verified  ? "nothing recorded to compare"
+              : result.matches ? "matches the recording"
+                               : "DIFFERS from the recording");
+  if (csv)
+    std::printf("Rolling checksum:  %016llx -> %s\n",
+                static_cast<unsigned long long>(result.rolling),
+                opt.checksumPath.c_str());
+  std::printf("--- Player ---\n");
+  std::printf("Money:             $%.2f\n", world.player.money);
+  std::printf("Fans:              %d\n", world.player.fans);
+  std::printf("Reputation:        %.2f\n", world.player.reputation);
+  std::printf("Songs / albums:    %zu / %zu live, %zu in the vault\n",
+              world.songs.Size(), world.albums.Size(), world.vault.Size());
+  return result.verified && !result.matches ? 1 : 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  SimOptions opt;
+  if (!ParseArgs(argc, argv, opt)) {
+    PrintUsage(argv[0]);
+    return 1;
+  }
+
+  if (opt.checkKernel)
+    return CheckKernel() ? 0 : 1;
+
+  if (!opt.dumpPath.empty()) {
+    std::string error;
+    if (!DumpTelemetryCsv(opt.dumpPath, stdout, error)) {
+      std::fprintf(stderr, "%s\n", error.c_str());
+      return 1;
+    }
+    return 0;
+  }
+
+  if (!opt.replayPath.empty())
+    return RunReplay(opt);
+
+  SetSimdLevel(opt.simd);
+  SetCurveMode(opt.curves);
+  if (opt.careers > 0)
+    return RunCareers(opt);
+
+  // 1. WORLD SETUP
+  EventLog log;
+  World world(opt.seed);
+  world.mode = opt.mode;
+  world.log = &log;
+  Player &player = world.player;
+  player.fans = opt.fans;
+  player.money = opt.money;
+
+  ReleaseCatalog &songsReleased = world.songs;
+  ReleaseCatalog &albumsReleased = world.albums;
+
+  // Setup and releases draw from the world's session stream
+  Random::StreamScope scope(world.rng);
+
+  if (!opt.loadPath.empty()) {
+    std::string error;
+    auto loadStart = std::chrono::steady_clock::now();
+    if (!LoadWorld(world, opt.loadPath, error)) {
+      std::fprintf(stderr, "Load failed: %s\n", error.c_str());
+      return 1;
+    }
+    world.mode = opt.mode;
+    std::chrono::duration<double, std::milli> loadTime =
+        std::chrono::steady_clock::now() - loadStart;
+    std::printf("Loaded %s in %.2f ms (%zu songs, %zu albums)\n",
+                opt.loadPath.c_str(), loadTime.count(), songsReleased.Size(),
+                albumsReleased.Size());
+  }
+
+  // A loaded career keeps its own catalog
+  for (int i = 0; opt.loadPath.empty() && i < opt.songs; ++i)
+    songsReleased.Add(MakeSingle(player, opt));
+
+  for (int i = 0; opt.loadPath.empty() && i < opt.albums; ++i) {
+    std::vector<Song> tracks;
+    std::vector<double> qualities;
+    for (int t = 0; t < opt.tracksPerAlbum; ++t) {
+      tracks.push_back(MakeSingle(player, opt));
+      qualities.push_back(tracks.back().quality);
+    }
+    double albumQuality = player.CalcAlbumQuality(qualities);
+    albumsReleased.Add(Album("Album " + std::to_string(i + 1), player.name,
+                             Genre::Pop, std::move(tracks), albumQuality,
+                             player.fans,
+                             GetRecommendedPrice(albumQuality, true)));
+  }
+
+  TelemetryRecorder telemetry;
+  if (!opt.telemetryPath.empty()) {
+    std::string error;
+    if (!telemetry.Open(opt.telemetryPath, error)) {
+      std::fprintf(stderr, "Telemetry: %s\n", error.c_str());
+      return 1;
+    }
+    world.economy.telemetry = &telemetry;
+  }
+
+  // 2. MAIN LOOP
+  // Every call advances exactly one economy tick, so the loop runs as fast
+  // as the CPU allows instead of at the render window's pace.
+  constexpr float dt = EconomyConfig::ECONOMY_TICK_RATE;
+  long long releases = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  for (long long tick = 0; tick < opt.ticks;) {
+    if (opt.releaseEvery > 0 && tick % opt.releaseEvery == 0) {
+      songsReleased.Add(MakeSingle(player, opt));
+      ++releases;
+    }
+
+    if (!opt.fastForward) {
+      StepWorld(world, dt);
+      ++tick;
+      continue;
+    }
+
+    // Fast-forward up to the next release
+    long long chunk = opt.ticks - tick;
+    if (opt.releaseEvery > 0)
+      chunk = std::min<long long>(chunk, opt.releaseEvery -
+                                             tick % opt.releaseEvery);
+    FastForwardWorld(world, static_cast<uint64_t>(chunk));
+    tick += chunk;
+  }
+  auto end = std::chrono::steady_clock::now();
+  double wallSeconds = std::chrono::duration<double>(end - start).count();
+
+  if (telemetry.IsOpen()) {
+    world.economy.telemetry = nullptr;
+    if (!telemetry.Close())
+      std::fprintf(stderr, "Telemetry: write failed\n");
+    std::printf("Telemetry:         %llu rows -> %s\n",
+                static_cast<unsigned long long>(telemetry.RowsWritten()),
+                opt.telemetryPath.c_str());
+  }
+
+  if (!opt.savePath.empty()) {
+    std::string error;
+    auto saveStart = std::chrono::steady_clock::now();
+    if (!SaveWorld(world, opt.savePath, error)) {
+      std::fprintf(stderr, "Save failed: %s\n", error.c_str());
+      return 1;
+    }
+    std::chrono::duration<double, std::milli> saveTime =
+        std::chrono::steady_clock::now() - saveStart;
+    std::printf("Saved %s in %.2f ms\n", opt.savePath.c_str(),
+                saveTime.count());
+  }
+
+  // 3. REPORT
+  long long totalStreams = 0;
+  long long totalSales = 0;
+  double catalogEarnings = 0.0;
+  for (const ReleaseCatalog *catalog : {&songsReleased, &albumsReleased}) {
+    for (size_t i = 0; i < catalog->Size(); ++i) {
+      totalStreams += catalog->totalStreams[i];
+      totalSales += catalog->totalSales[i];
+      catalogEarnings += catalog->earnings[i];
+    }
+  }
+
+  std::printf("--- Simulation ---\n");
+  std::printf("Ticks:             %lld (%.1f simulated seconds)\n", opt.ticks,
+              opt.ticks * static_cast<double>(dt));
+  std::printf("Wall time:         %.3f s (%.0f ticks/s)\n", wallSeconds,
+              wallSeconds > 0.0 ? opt.ticks / wallSeconds : 0.0);
+  std::printf("Singles released:  %lld during run\n", releases);
+  std::printf("Kernel:            %s\n", SimdLevelName(GetSimdLevel()));
+  std::printf("Curves:            %s\n", CurveModeName(GetCurveMode()));
+  std::printf("Tick mode:         %s%s (%zu threads)\n",
+              opt.mode == TickMode::Parallel ? "parallel" : "serial",
+              opt.fastForward ? " + fast-forward" : "",
+              opt.mode == TickMode::Parallel ? SharedThreadPool().Size()
+                                             : size_t{1});
+  std::printf("Seed:              %llu\n",
+              static_cast<unsigned long long>(opt.seed));
+  std::printf("--- Player ---\n");
+  std::printf("Money:             $%.2f\n", player.money);
+  std::printf("Fans:              %d\n", player.fans);
+  std::printf("Reputation:        %.2f\n", player.reputation);
+  std::printf("--- Live Catalog ---\n");
+  std::printf("Songs:             %zu\n", songsReleased.Size());
+  std::printf("Albums:            %zu\n", albumsReleased.Size());
+  std::printf("Streams:           %lld\n", totalStreams);
+  std::printf("Sales:             %lld\n", totalSales);
+  std::printf("Earnings:          $%.2f\n", catalogEarnings);
+
+  if (!log.Empty())
+    std::printf("Last event:        %s\n", log.Text(0).c_str());
+
+  return 0;
+}
@@ -0,0 +1,318 @@
+#include "../headers/simthread.h"
+#include "../headers/config.h"
+#include "../headers/helper.h"
+#include "../headers/replay.h"
+#include "../headers/savegame.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <utility>
+
+// ----------------------------------------------------------------------------
+// SNAPSHOT HAND-OFF
+// ----------------------------------------------------------------------------
+
+void SnapshotBuffer::Publish() {
+  // The old hand-off slot (acquired or not) becomes the next back buffer
+  uint32_t previous =
+      handoff.exchange(back | FRESH, std::memory_order_acq_rel);
+  back = previous & INDEX_MASK;
+}
+
+const WorldSnapshot &SnapshotBuffer::Acquire() {
+  if (handoff.load(std::memory_order_acquire) & FRESH) {
+    uint32_t previous = handoff.exchange(front, std::memory_order_acq_rel);
+    front = previous & INDEX_MASK;
+  }
+  return slots[front];
+}
+
+// ----------------------------------------------------------------------------
+// SIMULATION THREAD
+// ----------------------------------------------------------------------------
+
+SimulationThread::SimulationThread(World &world) : world(world) {}
+
+SimulationThread::~SimulationThread() { Stop(); }
+
+void SimulationThread::Start() {
+  if (Running())
+    return;
+
+  // The UI has something to draw before the first batch of ticks
+  Fill(snapshots.Back());
+  snapshots.Publish();
+
+  stopping = false;
+  thread = std::thread([this] { Run(); });
+}
+
+void SimulationThread::Stop() {
+  if (!Running())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wake.notify_all();
+  thread.join();
+}
+
+void SimulationThread::Post(SimCommand command) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    commands.push_back(std::move(command));
+  }
+  wake.notify_all();
+}
+
+void SimulationThread::SetSpeed(float newSpeed) {
+  speed.store(std::clamp(newSpeed, MIN_SPEED, MAX_SPEED));
+  wake.notify_all();
+}
+
+void SimulationThread::SetPaused(bool pause) {
+  paused.store(pause);
+  wake.notify_all();
+}
+
+void SimulationThread::Run() {
+  using Clock = std::chrono::steady_clock;
+  constexpr float TICK = EconomyConfig::ECONOMY_TICK_RATE;
+
+  // Recording and busking draw from the world's session stream
+  Random::StreamScope scope(world.rng);
+
+  double backlog = 0.0; // Game seconds due but not stepped yet
+  bool dirty = false;   // World changed since the last snapshot
+  auto last = Clock::now();
+  auto lastPublish = last;
+  std::vector<SimCommand> pending;
+
+  while (true) {
+    // 1. Apply what the UI posted, in order
+    bool stop;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      pending.swap(commands);
+      stop = stopping;
+    }
+    for (const SimCommand &command : pending)
+      Apply(command);
+    bool applied = !pending.empty();
+    pending.clear();
+    if (stop)
+      break;
+
+    // 2. Game time due since the last pass
+    auto now = Clock::now();
+    double wallSeconds = std::chrono::duration<double>(now - last).count();
+    last = now;
+    float currentSpeed = speed.load();
+    bool isPaused = paused.load();
+    if (!isPaused)
+      backlog += wallSeconds * currentSpeed;
+
+    // 3. Fixed steps: every call is exactly one economy tick. A pass never
+    // runs longer than a publish interval so commands and snapshots keep
+    // flowing at high speed.
+    while (backlog >= TICK) {
+      StepWorld(world, TICK);
+      if (recorder)
+        recorder->Stepped();
+      backlog -= TICK;
+      gameSeconds += TICK;
+      dirty = true;
+
+      std::chrono::duration<double> busy = Clock::now() - now;
+      if (busy.count() >= PUBLISH_INTERVAL)
+        break;
+    }
+
+    // Too far behind: slow down rather than skip ticks or spiral
+    lagging = backlog > MAX_BACKLOG;
+    backlog = std::min(backlog, MAX_BACKLOG);
+
+    // 4. Publish (at most once per interval, right away after a command)
+    now = Clock::now();
+    double sincePublish = std::chrono::duration<double>(now - lastPublish)
+                              .count();
+    if (applied || (dirty && sincePublish >= PUBLISH_INTERVAL)) {
+      Fill(snapshots.Back());
+      snapshots.Publish();
+      lastPublish = now;
+      sincePublish = 0.0;
+      dirty = false;
+    }
+
+    // 5. Sleep until the next tick is due, a snapshot is owed or the UI
+    // posts something
+    double wait = PUBLISH_INTERVAL;
+    if (!isPaused)
+      wait = std::min(wait, (TICK - backlog) / currentSpeed);
+    if (dirty)
+      wait = std::min(wait, PUBLISH_INTERVAL - sincePublish);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    wake.wait_for(lock, std::chrono::duration<double>(std::max(0.0, wait)),
+                  [&] { return stopping || !commands.empty(); });
+  }
+}
+
+// ----------------------------------------------------------------------------
+// PLAYER ACTIONS
+// ----------------------------------------------------------------------------
+
+void ApplyAction(World &world, const SimCommand &command) {
+  switch (command.kind) {
+  case SimCommandKind::RecordSong:
+    RecordSong(world, command.text, command.genre);
+    break;
+
+  case SimCommandKind::ReleaseSingle:
+    ReleaseSingle(world, command.song);
+    break;
+
+  case SimCommandKind::ReleaseAlbum:
+    ReleaseAlbum(world, command.text, command.tracks);
+    break;
+
+  case SimCommandKind::Upgrade:
+    BuyUpgrade(world, command.skill, command.index, command.cost,
+               command.gain);
+    break;
+
+  case SimCommandKind::Busk:
+    world.player.Busk(command.amount, world.log);
+    break;
+
+  case SimCommandKind::Rest:
+    world.player.Rest();
+    break;
+
+  case SimCommandKind::FastForward:
+    FastForwardWorld(world, command.index);
+    break;
+
+  case SimCommandKind::Save:
+  case SimCommandKind::Load:
+    break;
+  }
+}
+
+// ----------------------------------------------------------------------------
+// COMMANDS
+// ----------------------------------------------------------------------------
+
+void SimulationThread::Apply(const SimCommand &command) {
+  auto Log = [&](LogMessage id, const LogArgs &args = {}) {
+    if (world.log)
+      world.log->Add(id, args);
+  };
+
+  // Noted before it runs: vault handles are resolved against the vault the
+  // action sees
+  if (recorder)
+    recorder->Note(world, command);
+
+  switch (command.kind) {
+  case SimCommandKind::Save: {
+    std::string error;
+    if (SaveWorld(world, command.text, error))
+      Log(LogMessage::GameSaved);
+    else
+      Log(LogMessage::SaveFailed, {.text = error});
+    break;
+  }
+
+  case SimCommandKind::FastForward:
+    ApplyAction(world, command);
+    gameSeconds += command.index * static_cast<double>(
+                                       EconomyConfig::ECONOMY_TICK_RATE);
+    Log(LogMessage::SkippedDays,
+        {.number = static_cast<int64_t>(command.index)});
+    break;
+
+  case SimCommandKind::Load: {
+    std::string error;
+    if (LoadWorld(world, command.text, error)) {
+      Log(LogMessage::LoadedCareer, {.text = world.player.name});
+      if (recorder)
+        recorder->Snapshot(world); // The session continues from here
+    } else {
+      Log(LogMessage::LoadFailed, {.text = error});
+    }
+    break;
+  }
+
+  default:
+    ApplyAction(world, command);
+    break;
+  }
+}
+
+void SimulationThread::Fill(WorldSnapshot &snapshot) {
+  // Copy-assignment and clear() reuse each buffer's capacity, so
+  // steady-state publishing barely allocates
+  snapshot.tick = world.economy.tick;
+  snapshot.gameSeconds = gameSeconds;
+  snapshot.speed = speed.load();
+  snapshot.paused = paused.load();
+  snapshot.lagging = lagging;
+
+  snapshot.player = world.player;
+  if (snapshot.vault.Revision() != world.vault.Revision())
+    snapshot.vault = world.vault;
+  snapshot.market = world.economy.market;
+
+  // Charts: merge the two catalogs' age orders, newest first, up to
+  // CHART_ROWS rows
+  const ReleaseCatalog &songs = world.songs;
+  const ReleaseCatalog &albums = world.albums;
+  snapshot.songCount = songs.Size();
+  snapshot.albumCount = albums.Size();
+  snapshot.chart.clear();
+  snapshot.chartTracks.clear();
+  size_t songRank = 0;
+  size_t albumRank = 0;
+  while (snapshot.chart.size() < WorldSnapshot::CHART_ROWS &&
+         songRank + albumRank < songs.Size() + albums.Size()) {
+    bool album = songRank == songs.Size() ||
+                 (albumRank < albums.Size() &&
+                  albums.lifeTime[albums.Newest(albumRank)] <
+                      songs.lifeTime[songs.Newest(songRank)]);
+    const ReleaseCatalog &catalog = album ? albums : songs;
+    size_t i = album ? albums.Newest(albumRank++) : songs.Newest(songRank++);
+
+    ChartRow &row = snapshot.chart.emplace_back();
+    row.name = catalog.info[i].name;
+    row.album = album;
+    row.hype = catalog.hype[i];
+    row.dailyStreams = catalog.dailyStreams[i];
+    row.totalStreams = catalog.totalStreams[i];
+    row.totalSales = catalog.totalSales[i];
+    row.earnings = catalog.earnings[i];
+
+    // Per-track breakdown, attributed from the album's totals
+    const std::vector<SongId> &tracks = catalog.info[i].tracks;
+    row.firstTrack = static_cast<uint32_t>(snapshot.chartTracks.size());
+    row.trackCount = static_cast<uint32_t>(tracks.size());
+    if (tracks.empty())
+      continue;
+    catalog.trackStore.Attribute(tracks, catalog.totalStreams[i],
+                                 trackStreams);
+    catalog.trackStore.Attribute(tracks, catalog.earnings[i], trackEarnings);
+    for (size_t k = 0; k < tracks.size(); ++k) {
+      const Song &track = catalog.trackStore[tracks[k]];
+      snapshot.chartTracks.push_back(
+          {track.name, track.quality, trackStreams[k], trackEarnings[k]});
+    }
+  }
+
+  if (world.log)
+    snapshot.log = *world.log;
+  else
+    snapshot.log.Clear();
+}
@@ -1,25 +1,35 @@
 
 
 #include "../headers/Simulation.h"
-#include "../headers/album.h"
+#include "../headers/catalog.h"
 #include "../headers/config.h"
-#include "../headers/graphics.h"
+#include "../headers/eventlog.h"
 #include "../headers/helper.h"
+#include "../headers/performance.h"
 #include "../headers/player.h"
-#include "../headers/song.h"
+#include "../headers/rng.h"
+#include "../headers/telemetry.h"
+#include "../headers/threadpool.h"
 
 #include <algorithm>
+#include <climits>
 #include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <memory>
-#include <random>
 #include <string>
+#include <vector>
 
 // --- CORE SIMULATION LOGIC ---
-void UpdateFanbase(Player &player, int streams, double songQuality,
-                   double hype) {
+FanbaseDelta EvaluateFanbase(int fans, double reputation, int streams,
+                             double songQuality, double hype,
+                             CurveMode curves) {
+  FanbaseDelta delta;
+
   // 1. Safety & Triviality Check
   if (streams <= 0)
-    return;
+    return delta;
 
   // -------------------------------------------------------------------------
   // A. REPUTATION DYNAMICS
@@ -30,15 +40,16 @@ void UpdateFanbase(Player &player, int streams, double songQuality,
   } else if (songQuality <= 45.0) {
     repChange = -(50.0 - songQuality) * 0.02 * hype;
   }
-  player.reputation = std::clamp(player.reputation + repChange, 0.0, 1000.0);
+  delta.repChange = repChange;
+  reputation = std::clamp(reputation + repChange, 0.0, 1000.0);
 
   // -------------------------------------------------------------------------
   // B. MARKET SATURATION (Calculated early for use in conversion)
   // -------------------------------------------------------------------------
   // As you get bigger, it becomes harder to convince the remaining population.
   double saturation = 1.0;
-  if (player.fans > 1000000) {
-    double logFans = std::log10(static_cast<double>(player.fans));
+  if (fans > 1000000) {
+    double logFans = std::log10(static_cast<double>(fans));
     // Logistic damping: 1M fans -> ~0.33 multiplier
     saturation = std::clamp(1.0 / (logFans - 3.0), 0.01, 1.0);
   }
@@ -46,19 +57,14 @@ void UpdateFanbase(Player &player, int streams, double songQuality,
   // -------------------------------------------------------------------------
   // C. CONVERSION LOGIC (The Fix)
   // -------------------------------------------------------------------------
-  double conversionChance = 0.0;
-
   // FIX: Lower threshold from 50.0 to 10.0 so beginners can gain fans
-  if (songQuality > 10.0) {
-    // Base chance (0.2%) + Curve based on quality
-    // Quality 20 -> ~0.2%
-    // Quality 90 -> ~3.0%
-    conversionChance =
-        0.002 + (std::pow((songQuality - 10.0) / 90.0, 2.5) * 0.035);
-  }
+  // Base chance (0.2%) + Curve based on quality
+  // Quality 20 -> ~0.2%
+  // Quality 90 -> ~3.0%
+  double conversionChance = ConversionCurve(songQuality, curves);
 
   // Reputation Bonus
-  double trustFactor = 1.0 + (player.reputation / 200.0);
+  double trustFactor = 1.0 + (reputation / 200.0);
 
   // Calculate theoretical fans (Float precision)
   double theoreticalNewFans =
@@ -83,8 +89,7 @@ void UpdateFanbase(Player &player, int streams, double songQuality,
     if (Random::Chance(0.002)) {
       int viralSpike = static_cast<int>(streams * Random::Double(0.5, 2.0));
       newFans += viralSpike;
-      gameLog.Add("VIRAL SENSATION! " + std::to_string(viralSpike) +
-                  " new fans!");
+      delta.viralSpike = viralSpike;
     }
   }
 
@@ -92,22 +97,88 @@ void UpdateFanbase(Player &player, int streams, double songQuality,
   // E. BACKLASH (Reactionary Churn)
   // -------------------------------------------------------------------------
   int angryFans = 0;
-  if (player.fans > 1000 && songQuality < 15.0) {
+  if (fans > 1000 && songQuality < 15.0) {
     double disappointmentRate = (40.0 - songQuality) * 0.0005;
-    angryFans = static_cast<int>(player.fans * disappointmentRate);
+    angryFans = static_cast<int>(fans * disappointmentRate);
   }
 
+  delta.newFans = newFans;
+  delta.angryFans = angryFans;
+  return delta;
+}
+
+namespace {
+
+// Economy state behind the overloads that take no EconomyState
+EconomyState &ProcessEconomy() {
+  static EconomyState state;
+  return state;
+}
+
+// Seconds of clock between market shifts
+constexpr float TREND_DURATION = 45.0f;
+
+void LogViral(EventLog *log, int viralSpike) {
+  if (log)
+    log->Add(LogMessage::Viral, {.number = viralSpike});
+}
+
+void ApplyFanbase(Player &player, const FanbaseDelta &delta, EventLog *log) {
+  if (delta.viralSpike > 0)
+    LogViral(log, delta.viralSpike);
+
   // -------------------------------------------------------------------------
   // F. APPLY FINAL VALUES
   // -------------------------------------------------------------------------
-  player.fans += newFans;
-  player.fans = std::max(0, player.fans - angryFans);
+  player.reputation =
+      std::clamp(player.reputation + delta.repChange, 0.0, 1000.0);
+  player.fans += delta.newFans;
+  player.fans = std::max(0, player.fans - delta.angryFans);
+}
+
+} // namespace
+
+void UpdateFanbase(Player &player, int streams, double songQuality,
+                   double hype) {
+  ApplyFanbase(player,
+               EvaluateFanbase(player.fans, player.reputation, streams,
+                               songQuality, hype, GetCurveMode()),
+               &gameLog);
+}
+
+double CatalogReputation(const ReleaseCatalog &songs,
+                         const ReleaseCatalog &albums) {
+  // O(1): the catalogs keep their quality sums as releases come and go
+  double songScore = songs.qualitySum;
+  double albumScore = albums.qualitySum;
+
+#ifdef MUSICTYCOON_CHECK_REPUTATION
+  // Debug builds: the running sums must match a full re-sum (up to the
+  // rounding of adding and removing in a different order)
+  for (const ReleaseCatalog *catalog : {&songs, &albums}) {
+    double exact = catalog->SumQuality();
+    double tolerance = 1e-9 * std::max(1.0, exact);
+    if (std::fabs(catalog->qualitySum - exact) > tolerance) {
+      std::fprintf(stderr,
+                   "Reputation check failed (%s): running sum %.17g, "
+                   "re-sum %.17g\n",
+                   catalog->isAlbum ? "albums" : "songs",
+                   catalog->qualitySum, exact);
+      std::abort();
+    }
+  }
+#endif
+
+  // Combine, normalize (divide by 100), and clamp
+  double rawReputation = (songScore + albumScore) / 100.0;
+  return std::clamp(rawReputation, 0.0, 5.0);
 }
 
 // Returns true if an update occurred (useful for triggering UI sounds/visuals)
-bool UpdateReputation(Player &player, const std::vector<Song> &songs,
-                      const std::vector<Album> &albums,
-                      const std::shared_ptr<float> &deltaTimePtr) {
+bool UpdateReputation(Player &player, const ReleaseCatalog &songs,
+                      const ReleaseCatalog &albums,
+                      const std::shared_ptr<float> &deltaTimePtr,
+                      TelemetryRecorder *telemetry) {
 
   // 1. Safety Checks
   if (!deltaTimePtr)
@@ -125,31 +196,17 @@ bool UpdateReputation(Player &player, const std::vector<Song> &songs,
     player.repUpdateAccumulator -= EconomyConfig::REP_CYCLE;
 
     // Optimization: Early exit if inventory is empty
-    if (songs.empty() && albums.empty()) {
+    if (songs.Empty() && albums.Empty()) {
       player.reputation = 0.0;
+      if (telemetry)
+        telemetry->NoteReputation(player.reputation);
       return true;
     }
 
-    // 4. Calculate using C++20 Ranges (Clean & readable)
-    // We project the 'quality' member and sum it up.
-
-    // Sum Songs
-    double songScore = 0.0;
-    for (const auto &song : songs) {
-      songScore += song.quality;
-    }
-
-    // Sum Albums
-    double albumScore = 0.0;
-    for (const auto &album : albums) {
-      albumScore += album.quality;
-    }
-
-    // 5. Apply Logic
-    // Combine, normalize (divide by 100), and clamp
-    double rawReputation = (songScore + albumScore) / 100.0;
-
-    player.reputation = std::clamp(rawReputation, 0.0, 5.0);
+    // 4. Recompute from the live catalog
+    player.reputation = CatalogReputation(songs, albums);
+    if (telemetry)
+      telemetry->NoteReputation(player.reputation);
 
     return true; // Indicate that values changed
   }
@@ -157,81 +214,274 @@ bool UpdateReputation(Player &player, const std::vector<Song> &songs,
   return false; // No update this frame
 }
 
-std::pair<float, std::string_view>
-GetMarketTrend(std::shared_ptr<float> tickTimer) {
+std::pair<float, Genre> GetMarketTrend(std::shared_ptr<float> tickTimer) {
   // 1. Safety check
   if (!tickTimer) {
-    return {1.0f, "Neutral"};
+    return {1.0f, Genre::Mixed}; // Nothing trends
   }
 
-  // 2. Persistent State
-  static bool initialized = false;
-  static float currentMultiplier = 1.0f;
-  static size_t currentGenreIndex =
-      0; // Store index, faster than string comparison
-
-  // Static constant data
-  static const std::vector<std::string> genres = {
-      "Pop", "Rock", "Hip-Hop", "R&B", "Jazz", "Classical", "Other"};
+  EconomyState &state = ProcessEconomy();
+  state.seed = Random::GetSeed();
+  return GetMarketTrend(state, *tickTimer, &gameLog);
+}
 
-  // Modern Random Number Generation (Standard C++)
-  // Initialized once (static)
-  static std::mt19937 gen(std::random_device{}());
+std::pair<float, Genre> GetMarketTrend(EconomyState &state, float &tickTimer,
+                                       EventLog *log) {
+  // 2. Persistent State (per world)
+  MarketState &market = state.market;
 
-  constexpr float TREND_DURATION = 45.0f;
+  // Every recordable genre can trend
+  constexpr int genreCount = static_cast<int>(GENRE_COUNT);
 
   // Helper lambda to pick a new multiplier
-  auto PickMultiplier = [&]() -> float {
+  auto PickMultiplier = [&](RandomStream &rng) -> float {
     // NOTE: Your original code used Normal(0.5, 0.1).
     // This results in a value around 0.5. If this is a "Bonus",
     // usually you want values > 1.0.
     // If you intended a nerf, keep it as is.
     // Below preserves your exact original logic:
-    return std::max(0.1f, (float)Random::Normal(0.5, 0.1));
+    return std::max(0.1f, (float)rng.Normal(0.5, 0.1));
   };
 
   // 3. First Run Initialization
-  if (!initialized) {
-    std::uniform_int_distribution<size_t> dist(0, genres.size() - 1);
-    currentGenreIndex = dist(gen);
-    currentMultiplier = PickMultiplier();
-    initialized = true;
+  if (!market.initialized) {
+    RandomStream rng(state.seed, RngStream::Market, market.shiftCount++);
+    market.genre = GenreAt(rng.Int(0, genreCount - 1));
+    market.multiplier = PickMultiplier(rng);
+    market.initialized = true;
   }
 
   // 4. Update Logic
-  if (*tickTimer >= TREND_DURATION) {
+  if (tickTimer >= TREND_DURATION) {
     // Soft Reset: Preserve overshoot to maintain time accuracy
-    *tickTimer -= TREND_DURATION;
+    tickTimer -= TREND_DURATION;
+
+    // Each shift draws from its own stream
+    RandomStream rng(state.seed, RngStream::Market, market.shiftCount++);
 
     // Pick a NEW genre index (ensure it is different)
-    std::uniform_int_distribution<size_t> dist(0, genres.size() - 1);
-    size_t newIndex = currentGenreIndex;
+    Genre newGenre = market.genre;
 
-    while (newIndex == currentGenreIndex) {
-      newIndex = dist(gen);
+    while (newGenre == market.genre) {
+      newGenre = GenreAt(rng.Int(0, genreCount - 1));
     }
-    currentGenreIndex = newIndex;
+    market.genre = newGenre;
 
     // Pick new multiplier
-    currentMultiplier = PickMultiplier();
+    market.multiplier = PickMultiplier(rng);
+
+    // Formatted only if the line is shown
+    if (log) {
+      log->Add(LogMessage::MarketShift,
+               {.value = market.multiplier, .genre = market.genre});
+    }
+  }
 
-    // C++20 std::format - cleaner and faster than stringstream
-    std::string logMsg =
-        std::format("Market Shift! Trending: {} (+{:.2f}x bonus)",
-                    genres[currentGenreIndex], currentMultiplier);
+  // Return id (names are looked up by the UI) + current value
+  return {market.multiplier, market.genre};
+}
 
-    gameLog.Add(logMsg);
+namespace {
+
+// Everything a release needs to know about the current tick.
+struct TickContext {
+  uint64_t seed = 0;
+  uint64_t tick = 0;
+  Genre trending = Genre::Mixed;
+  float trendMultiplier = 1.0f;
+  SimdLevel simdLevel = SimdLevel::Scalar;
+  CurveMode curves = CurveMode::Exact;
+  EventLog *log = nullptr;
+};
+
+// Per-range results of a tick. Parallel chunks merge the player deltas
+// once the tick is done; every range reports its streams and deaths.
+struct TickTotals {
+  double revenue = 0.0;
+  double repChange = 0.0;
+  long long newFans = 0;
+  long long angryFans = 0;
+
+  long long dailyStreams = 0;
+  std::vector<uint32_t> died; // Ascending; demoted after the tick
+};
+
+constexpr size_t BLOCK_SIZE = 256;      // Releases per kernel call
+constexpr size_t PARALLEL_CHUNK = 4096; // Releases per parallel task
+
+// -------------------------------------------------------------------------
+// REALISTIC STREAM ALGORITHM (Batched)
+// -------------------------------------------------------------------------
+// Simulates releases [begin, end) of 'catalog' for one tick, in blocks:
+//   a) draw the random inputs (viral base) and trend bonuses,
+//   b) run the batched kernel (performance.cpp) for the heavy,
+//      player-independent math: freshness decay, demand curve, quality
+//      power and sales chance,
+//   c) finish each release.
+// With applyLive (serial mode) each release updates 'player' right away, so
+// the next one sees the new fans and reputation. Otherwise 'player' is only
+// read (tick-start snapshot) and all deltas go into 'totals'.
+// Every release draws from its own (release id, tick) streams, so results
+// do not depend on iteration order or thread.
+void SimulateRange(ReleaseCatalog &catalog, size_t begin, size_t end,
+                   const TickContext &ctx, Player &player, bool applyLive,
+                   TickTotals &totals) {
+  const bool isAlbum = catalog.isAlbum;
+  const RngStream viralStream =
+      isAlbum ? RngStream::AlbumViral : RngStream::SongViral;
+  const RngStream tickStream =
+      isAlbum ? RngStream::AlbumTick : RngStream::SongTick;
+
+  // Reputation boost only changes when reputation does, so cache the log10
+  double boostReputation = -1.0;
+  double repBoost = 1.0;
+
+  double trendBonus[BLOCK_SIZE];
+  double viralBase[BLOCK_SIZE];
+  double organic[BLOCK_SIZE];
+
+  for (size_t start = begin; start < end; start += BLOCK_SIZE) {
+    const size_t n = std::min(BLOCK_SIZE, end - start);
+
+    // a) Random inputs & Market Trend Impact (The "Zeitgeist" Factor)
+    for (size_t j = 0; j < n; ++j) {
+      size_t i = start + j;
+      trendBonus[j] = 1.0;
+      viralBase[j] = 0.0;
+      if (catalog.hype[i] <= ReleaseCatalog::DEAD_HYPE)
+        continue; // Dead release, skipped below
+
+      // Albums never ride genre trends (they used to pass "Album")
+      if (!isAlbum && catalog.genre[i] == ctx.trending) {
+        trendBonus[j] = 1.0 + ctx.trendMultiplier; // 1.5x to 3.0x visibility
+      }
+      RandomStream rng(ctx.seed, viralStream, catalog.id[i], ctx.tick);
+      viralBase[j] = rng.Normal(isAlbum ? 150.0 : 50.0, 15.0);
+    }
+
+    // b) Batched kernel
+    PerformanceBatch batch;
+    batch.count = n;
+    batch.curves = ctx.curves;
+    batch.hype = catalog.hype.data() + start;
+    batch.lifeTime = catalog.lifeTime.data() + start;
+    batch.decayTime = catalog.decayTime.data() + start;
+    batch.qualityPower = catalog.qualityPower.data() + start;
+    batch.trendBonus = trendBonus;
+    batch.viralBase = viralBase;
+    batch.organic = organic;
+    EvaluatePerformance(batch, ctx.simdLevel);
+
+    // c) Finish each release
+    for (size_t j = 0; j < n; ++j) {
+      size_t i = start + j;
+      const double quality = catalog.quality[i];
+      const double hype = catalog.hype[i];
+
+      if (hype <= ReleaseCatalog::DEAD_HYPE) {
+        totals.died.push_back(static_cast<uint32_t>(i));
+        continue; // Dead release (not demoted yet)
+      }
+
+      // Long-tail and fanbase rolls come from this release's stream
+      RandomStream rng(ctx.seed, tickStream, catalog.id[i], ctx.tick);
+      Random::StreamScope scope(rng);
+
+      // 1. Fan Reach: Not all fans see the content.
+      // Higher reputation = higher reach.
+      double reachPercent = std::clamp(player.reputation / 1000.0, 0.05, 0.40);
+      double activeFanListeners = player.fans * reachPercent * hype;
+
+      // Total Daily Streams
+      double totalListeners = activeFanListeners + organic[j];
+
+      // Reputation Multiplier (Global fame boost)
+      if (player.reputation != boostReputation) {
+        boostReputation = player.reputation;
+        repBoost = 1.0 + (std::log10(std::max(1.0, player.reputation)) * 0.1);
+      }
+
+      int streams =
+          static_cast<int>(totalListeners * catalog.demand[i] * repBoost);
+
+      // Determine "Guaranteed" streams (The long tail)
+      // Even dead songs get 1-5 streams a day if they are in the catalog.
+      if (streams < 5 && catalog.lifeTime[i] > 0)
+        streams = Random::Int(0, 2);
+
+      // E. Sales Conversion (The Funnel)
+      int sales = 0;
+      if (streams > 0) {
+        // Simple optimization for large numbers
+        sales = static_cast<int>(streams * catalog.salesChance[i]);
+      }
+
+      // F. Decay Calculation (Next Day's Hype)
+      // Hype decays naturally, but sales/streams regenerate it slightly
+      // (Word of Mouth).
+      double naturalDecay = (quality > 85.0) ? 0.995 : 0.97;
+      double tractionRestoration = (streams > 1000) ? 0.005 : 0.0;
+      double nextHype = hype * (naturalDecay + tractionRestoration);
+
+      // Apply Stats
+      double revenue = (streams * EconomyConfig::STREAM_PAYOUT_RATE) +
+                       (sales * catalog.price[i]);
+      catalog.dailyStreams[i] = streams;
+      catalog.totalStreams[i] += streams;
+      catalog.totalSales[i] += sales;
+      catalog.earnings[i] += revenue;
+      catalog.hype[i] = std::clamp(nextHype, 0.0, 10.0); // Soft cap hype
+      totals.dailyStreams += streams;
+      if (catalog.hype[i] <= ReleaseCatalog::DEAD_HYPE)
+        totals.died.push_back(static_cast<uint32_t>(i)); // Dead from now on
+
+      // Apply Financials + Feedback Loop: Good performance grows fans
+      FanbaseDelta delta =
+          EvaluateFanbase(player.fans, player.reputation, streams, quality,
+                          catalog.hype[i], ctx.curves);
+      if (applyLive) {
+        player.money += revenue;
+        ApplyFanbase(player, delta, ctx.log);
+      } else {
+        totals.revenue += revenue;
+        totals.repChange += delta.repChange;
+        totals.newFans += delta.newFans;
+        totals.angryFans += delta.angryFans;
+        if (delta.viralSpike > 0)
+          LogViral(ctx.log, delta.viralSpike); // Add() is multi-producer
+      }
+    }
   }
+}
 
-  // Return string_view (no copy) + current value
-  return {currentMultiplier, genres[currentGenreIndex]};
+// Moves the releases a range found dead to the dormant range. Ranges must
+// be passed from last to first: walking indices downwards means the release
+// Demote() swaps in is never one still waiting.
+void DemoteDied(ReleaseCatalog &catalog, const TickTotals &totals) {
+  for (auto it = totals.died.rbegin(); it != totals.died.rend(); ++it)
+    catalog.Demote(*it);
 }
 
-void SimulateEconomy(std::vector<Song> &songs, std::vector<Album> &albums,
-                     Player &player, sf::Time dt,
-                     std::shared_ptr<float> globalClock) {
+} // namespace
+
+void SimulateEconomy(ReleaseCatalog &songs, ReleaseCatalog &albums,
+                     Player &player, float dt,
+                     std::shared_ptr<float> globalClock, TickMode mode) {
 
-  if ((songs.empty() && albums.empty()) || !globalClock)
+  if ((songs.Empty() && albums.Empty()) || !globalClock)
+    return;
+
+  EconomyState &state = ProcessEconomy();
+  state.seed = Random::GetSeed();
+  SimulateEconomy(state, songs, albums, player, dt, *globalClock, &gameLog,
+                  mode);
+}
+
+void SimulateEconomy(EconomyState &state, ReleaseCatalog &songs,
+                     ReleaseCatalog &albums, Player &player, float dt,
+                     float &globalClock, EventLog *log, TickMode mode) {
+
+  if (songs.Empty() && albums.Empty())
     return;
 
   // -------------------------------------------------------------------------
@@ -239,171 +489,113 @@ void SimulateEconomy(std::vector<Song> &songs, std::vector<Album> &albums,
   // -------------------------------------------------------------------------
 
   // Increment the Global Clock (used for Market Trends ~45s cycles)
-  *globalClock += dt.asSeconds();
+  globalClock += dt;
 
   // Update Lifetime for all items
-  for (auto &song : songs)
-    song.lifeTime += dt.asSeconds();
-  for (auto &album : albums)
-    album.lifeTime += dt.asSeconds();
+  for (float &lifeTime : songs.lifeTime)
+    lifeTime += dt;
+  for (float &lifeTime : albums.lifeTime)
+    lifeTime += dt;
 
   // Check Market Trend (Once per frame to ensure UI updates, but logic changes
   // slowly) We pass the globalClock to the trend manager.
-  auto [trendMultiplier, trendingGenre] = GetMarketTrend(globalClock);
+  auto [trendMultiplier, trendingGenre] =
+      GetMarketTrend(state, globalClock, log);
 
   // -------------------------------------------------------------------------
   // 2. ECONOMY TICK ACCUMULATOR
   // -------------------------------------------------------------------------
-  // We use a local static accumulator so we don't reset the GlobalClock
+  // We use a separate accumulator so we don't reset the GlobalClock
   // which is needed for the 45-second trend cycles.
-  static float economyAccumulator = 0.0f;
-  economyAccumulator += dt.asSeconds();
+  state.accumulator += dt;
 
   // If we haven't reached the "End of Day" (Tick Rate), exit.
-  if (economyAccumulator < EconomyConfig::ECONOMY_TICK_RATE) {
+  if (state.accumulator < EconomyConfig::ECONOMY_TICK_RATE) {
     return;
   }
 
   // Reset accumulator but keep the overshoot for time precision
-  economyAccumulator -= EconomyConfig::ECONOMY_TICK_RATE;
-
-  // -------------------------------------------------------------------------
-  // 3. HELPER: REALISTIC STREAM ALGORITHM
-  // -------------------------------------------------------------------------
-  // Defines how media performs based on real-world factors.
-  auto CalculatePerformance =
-      [&](double quality, double hype, double price, double lifeTime,
-          const std::string &genre,
-          bool isAlbum) -> std::tuple<int, int, double> {
-    // A. Market Trend Impact (The "Zeitgeist" Factor)
-    // If trending, acts as a multiplier on DISCOVERY, not just cash.
-    double trendBonus = 1.0;
-    if (genre == trendingGenre) {
-      trendBonus = 1.0 + trendMultiplier; // e.g., 1.5x to 3.0x visibility
-    }
-
-    // B. The "Freshness" Curve (Exponential Decay)
-    // New releases spike hard, then stabilize.
-    // Albums stay fresh longer (decay divisor 200.0 vs 120.0).
-    double decaySpeed = isAlbum ? 200.0 : 120.0;
-    // Quality slows down decay (Great songs stay relevant).
-    double qualityPreservation = std::max(1.0, quality / 20.0);
-    double ageFactor =
-        std::exp(-(lifeTime / (decaySpeed * qualityPreservation)));
-
-    // C. Price Elasticity (Demand Curve)
-    // People tolerate high prices for High Quality/Hype, but punish it for low
-    // quality.
-    double recommendedPrice = GetRecommendedPrice(quality, isAlbum);
-    double priceRatio = price / std::max(0.01, recommendedPrice);
-    // If price is too high (>1.5x fair), demand creates a cliff drop.
-    double demandMod =
-        (priceRatio > 1.5)
-            ? std::pow(priceRatio, -3.0)
-            : std::pow(priceRatio, -EconomyConfig::PRICE_ELASTICITY);
-
-    // D. Listener Logic (The Core Simulation)
-
-    // 1. Fan Reach: Not all fans see the content.
-    // Higher reputation = higher reach.
-    double reachPercent = std::clamp(player.reputation / 1000.0, 0.05, 0.40);
-    double activeFanListeners = player.fans * reachPercent * hype;
-
-    // 2. Organic Discovery (Viral Potential)
-    // Non-linear: 90 quality is 4x better than 45, not 2x.
-    double qualityPower = std::pow(quality / 10.0, 2.5);
-    double viralBase = Random::Normal(isAlbum ? 150.0 : 50.0, 15.0);
-    double organicListeners =
-        viralBase * qualityPower * trendBonus * ageFactor * hype;
-
-    // Total Daily Streams
-    double totalListeners = activeFanListeners + organicListeners;
-
-    // Reputation Multiplier (Global fame boost)
-    double repBoost =
-        1.0 + (std::log10(std::max(1.0, player.reputation)) * 0.1);
-
-    int streams = static_cast<int>(totalListeners * demandMod * repBoost);
-
-    // Determine "Guaranteed" streams (The long tail)
-    // Even dead songs get 1-5 streams a day if they are in the catalog.
-    if (streams < 5 && lifeTime > 0)
-      streams = Random::Int(0, 2);
-
-    // E. Sales Conversion (The Funnel)
-    // Harder to sell than stream. Requires high engagement (Hype + Quality).
-    double baseConversion = isAlbum ? (1.0 / 1000.0) : (1.0 / 600.0);
-    double salesChance = baseConversion * (quality / 50.0) * demandMod;
-
-    // Binomial distribution approximation for sales
-    int sales = 0;
-    if (streams > 0) {
-      // Simple optimization for large numbers
-      sales = static_cast<int>(streams * salesChance);
-    }
+  state.accumulator -= EconomyConfig::ECONOMY_TICK_RATE;
 
-    // F. Decay Calculation (Next Day's Hype)
-    // Hype decays naturally, but sales/streams regenerate it slightly (Word of
-    // Mouth).
-    double naturalDecay = (quality > 85.0) ? 0.995 : 0.97;
-    double tractionRestoration = (streams > 1000) ? 0.005 : 0.0;
-    double nextHype = hype * (naturalDecay + tractionRestoration);
-
-    return {streams, sales, nextHype};
-  };
+  // Tick index keys every random stream drawn this tick
+  const uint64_t tick = state.tick++;
+  const uint64_t seed = state.seed;
 
   // -------------------------------------------------------------------------
-  // 4. EXECUTE SIMULATION (Songs)
+  // 3. REALISTIC STREAM ALGORITHM (see SimulateRange)
   // -------------------------------------------------------------------------
-  for (auto &song : songs) {
-    if (song.hype <= 0.001f) {
-      song.dailyStreams = 0;
-      continue; // Dead song
-    }
-
-    auto [streams, sales, nextHype] = CalculatePerformance(
-        song.quality, song.hype, song.price, song.lifeTime, song.genre, false);
-
-    // Apply Financials
-    double revenue =
-        (streams * EconomyConfig::STREAM_PAYOUT_RATE) + (sales * song.price);
-    player.money += revenue;
-
-    // Apply Stats
-    song.dailyStreams = streams;
-    song.totalStreams += streams;
-    song.totalSales += sales;
-    song.earnings += revenue;
-    song.hype = std::clamp(nextHype, 0.0, 10.0); // Soft cap hype
-
-    // Feedback Loop: Good performance grows fans
-    UpdateFanbase(player, streams, song.quality, song.hype);
-  }
+  TickContext ctx;
+  ctx.seed = seed;
+  ctx.tick = tick;
+  ctx.trending = trendingGenre;
+  ctx.trendMultiplier = trendMultiplier;
+  ctx.simdLevel = GetSimdLevel();
+  ctx.curves = GetCurveMode();
+  ctx.log = log;
+
+  // Release-time invariants follow the curve mode (no-op unless it changed)
+  songs.SetCurveMode(ctx.curves);
+  albums.SetCurveMode(ctx.curves);
 
   // -------------------------------------------------------------------------
-  // 5. EXECUTE SIMULATION (Albums)
+  // 4. EXECUTE SIMULATION (Songs, then Albums)
   // -------------------------------------------------------------------------
-  for (auto &album : albums) {
-    if (album.hype <= 0.001f) {
-      album.dailyStreams = 0;
-      continue;
+  // Only the active ranges: dormant releases never stream again
+  long songDailyStreams = 0;
+  long long albumDailyStreams = 0;
+  TickTotals songTotals;
+  TickTotals albumTotals;
+  std::vector<TickTotals> chunkTotals;
+  size_t songChunks = 0;
+
+  if (mode == TickMode::Serial) {
+    SimulateRange(songs, 0, songs.ActiveSize(), ctx, player, true,
+                  songTotals);
+    SimulateRange(albums, 0, albums.ActiveSize(), ctx, player, true,
+                  albumTotals);
+    songDailyStreams = static_cast<long>(songTotals.dailyStreams);
+    albumDailyStreams = albumTotals.dailyStreams;
+  } else {
+    // Fixed chunk boundaries (independent of thread count) keep the merge
+    // order, and therefore the floating-point sums, reproducible.
+    songChunks = (songs.ActiveSize() + PARALLEL_CHUNK - 1) / PARALLEL_CHUNK;
+    const size_t albumChunks =
+        (albums.ActiveSize() + PARALLEL_CHUNK - 1) / PARALLEL_CHUNK;
+    chunkTotals.resize(songChunks + albumChunks);
+
+    SharedThreadPool().ParallelFor(chunkTotals.size(), [&](size_t chunk) {
+      bool isSong = chunk < songChunks;
+      ReleaseCatalog &catalog = isSong ? songs : albums;
+      size_t begin = (isSong ? chunk : chunk - songChunks) * PARALLEL_CHUNK;
+      size_t end = std::min(begin + PARALLEL_CHUNK, catalog.ActiveSize());
+      SimulateRange(catalog, begin, end, ctx, player, false,
+                    chunkTotals[chunk]);
+    });
+
+    // -----------------------------------------------------------------------
+    // 5. DETERMINISTIC REDUCTION (chunk order)
+    // -----------------------------------------------------------------------
+    double repChange = 0.0;
+    long long newFans = 0;
+    long long angryFans = 0;
+    for (size_t chunk = 0; chunk < chunkTotals.size(); ++chunk) {
+      const TickTotals &totals = chunkTotals[chunk];
+      if (chunk < songChunks)
+        songDailyStreams += static_cast<long>(totals.dailyStreams);
+      else
+        albumDailyStreams += totals.dailyStreams;
+
+      player.money += totals.revenue;
+      repChange += totals.repChange;
+      newFans += totals.newFans;
+      angryFans += totals.angryFans;
     }
 
-    auto [streams, sales, nextHype] = CalculatePerformance(
-        album.quality, album.hype, album.price, album.lifeTime, "Album", true);
-
-    double revenue =
-        (streams * EconomyConfig::STREAM_PAYOUT_RATE) + (sales * album.price);
-    player.money += revenue;
-
-    album.dailyStreams = streams;
-    album.totalStreams += streams;
-    album.totalSales += sales;
-    album.earnings += revenue;
-    album.hype = std::clamp(nextHype, 0.0, 10.0);
-
-    // Albums have a stronger effect on fanbase retention than singles
-    UpdateFanbase(player, streams, album.quality, album.hype);
+    player.reputation =
+        std::clamp(player.reputation + repChange, 0.0, 1000.0);
+    long long fans = static_cast<long long>(player.fans) + newFans - angryFans;
+    player.fans = static_cast<int>(
+        std::clamp(fans, 0LL, static_cast<long long>(INT_MAX)));
   }
 
   // -------------------------------------------------------------------------
@@ -421,12 +613,8 @@ void SimulateEconomy(std::vector<Song> &songs, std::vector<Album> &albums,
 
   // B. Inactivity Penalty
   // If user has no active songs (total streams low), churn increases.
-  // We calculate total active streams for today first.
-  long totalDailyStreams = 0;
-  for (const auto &s : songs)
-    totalDailyStreams += s.dailyStreams;
-
-  if (totalDailyStreams < 100 && player.fans > 500) {
+  // Today's singles streams were summed during the main pass.
+  if (songDailyStreams < 100 && player.fans > 500) {
     churnRate *= 2.0; // Fans leave if you are silent
   }
 
@@ -434,13 +622,689 @@ void SimulateEconomy(std::vector<Song> &songs, std::vector<Album> &albums,
 
   // C. Scandal Event (Random Bad Luck)
   // Realism: Scandals are rare (0.1% chance per day), but impactful.
-  if (player.fans > 1000 && Random::Chance(0.001)) {
+  RandomStream churnRng(seed, RngStream::Churn, 0, tick);
+  if (player.fans > 1000 && churnRng.Chance(0.001)) {
     int scandalLoss =
-        static_cast<int>(player.fans * Random::Double(0.02, 0.05));
+        static_cast<int>(player.fans * churnRng.Double(0.02, 0.05));
     lostFans += scandalLoss;
-    gameLog.Add("SCANDAL: Bad press caused " + std::to_string(scandalLoss) +
-                " fans to leave!");
+    if (log)
+      log->Add(LogMessage::Scandal, {.number = scandalLoss});
   }
 
   player.fans = std::max(0, player.fans - lostFans);
-}
\ No newline at end of file
+
+  // -------------------------------------------------------------------------
+  // 7. TELEMETRY (one row per tick, no allocation)
+  // -------------------------------------------------------------------------
+  if (state.telemetry) {
+    TelemetryRow row;
+    row.tick = tick;
+    row.money = player.money;
+    row.reputation = player.reputation;
+    row.dailyStreams = songDailyStreams + albumDailyStreams;
+    row.fans = player.fans;
+    row.songs = static_cast<uint32_t>(songs.Size());
+    row.albums = static_cast<uint32_t>(albums.Size());
+    row.trendMultiplier = trendMultiplier;
+    row.trendGenre = static_cast<uint8_t>(trendingGenre);
+    state.telemetry->Append(row);
+  }
+
+  // -------------------------------------------------------------------------
+  // 8. RETIRE DEAD RELEASES (last range first, see DemoteDied)
+  // -------------------------------------------------------------------------
+  if (mode == TickMode::Serial) {
+    DemoteDied(songs, songTotals);
+    DemoteDied(albums, albumTotals);
+  } else {
+    for (size_t chunk = chunkTotals.size(); chunk-- > 0;)
+      DemoteDied(chunk < songChunks ? songs : albums, chunkTotals[chunk]);
+  }
+}
+
+// ----------------------------------------------------------------------------
+// ANALYTIC FAST-FORWARD
+// ----------------------------------------------------------------------------
+
+namespace {
+
+// Thresholds of the per-tick model (SimulateRange, EvaluateFanbase and the
+// churn block above). A span is only taken analytically if none of them can
+// be crossed inside it.
+constexpr double TRACTION_STREAMS = 1000.0; // Hype restoration above this
+constexpr double VIRAL_HYPE = 2.0;          // Viral spikes need more hype...
+constexpr double VIRAL_QUALITY = 80.0;      // ...and more quality than this
+constexpr double BACKLASH_QUALITY = 15.0;   // Backlash below this quality...
+constexpr int BACKLASH_FANS = 1000;         // ...once above this many fans
+constexpr int CHURN_FANS = 10000;           // No churn at or below this
+constexpr double TAIL_STREAMS = 5.0;        // Long tail below this
+constexpr double INACTIVE_STREAMS = 100.0;  // Doubled churn below this
+constexpr double DEAD_HYPE = ReleaseCatalog::DEAD_HYPE;
+constexpr double SCANDAL_CHANCE = 0.001;
+constexpr int FAN_BANDS[] = {500, 1000, 10000, 100000, 1000000};
+
+constexpr uint64_t MIN_SPAN = 8;       // Shorter spans are stepped normally
+constexpr double NOISE_SIGMAS = 6.0;   // Safety margin on normal draws
+constexpr double FAN_DRIFT = 0.05;     // Max relative fan change per span...
+constexpr double MIN_FAN_DRIFT = 100.0; // ...but always allow this many
+
+// Which band of the fan-dependent rules 'fans' falls in.
+int FanBand(double fans) {
+  int band = 0;
+  for (int edge : FAN_BANDS)
+    band += fans > edge;
+  return band;
+}
+
+// Per-tick hype decay of a release (SimulateRange, without traction).
+double HypeDecay(double quality) { return (quality > 85.0) ? 0.995 : 0.97; }
+
+// Ticks until a release at 'lifeTime' is removed (it is removed after the
+// tick its lifeTime reaches the limit); at least 1.
+uint64_t TicksUntilExpiry(float lifeTime, float maxLifeTime, double dt) {
+  double ticksLeft = std::ceil((maxLifeTime - lifeTime) / dt);
+  return static_cast<uint64_t>(std::max(1.0, ticksLeft));
+}
+
+// Fans 'fans' can gain without leaving its band (infinite in the top one).
+double BandRoom(double fans) {
+  for (int edge : FAN_BANDS) {
+    if (fans <= edge)
+      return edge - fans;
+  }
+  return HUGE_VAL;
+}
+
+// sum_{j < count} r^j
+double Geometric(double r, uint64_t count) {
+  if (count == 0)
+    return 0.0;
+  if (std::fabs(1.0 - r) < 1e-12)
+    return static_cast<double>(count);
+  return (1.0 - std::pow(r, static_cast<double>(count))) / (1.0 - r);
+}
+
+// Number of leading t in [1, limit] for which 'holds' is true. 'holds' must
+// be true up to some t and false after it.
+template <typename Pred> uint64_t CountLeading(uint64_t limit, Pred holds) {
+  uint64_t lo = 0;
+  uint64_t hi = limit;
+  while (lo < hi) {
+    uint64_t mid = lo + (hi - lo + 1) / 2;
+    if (holds(mid))
+      lo = mid;
+    else
+      hi = mid - 1;
+  }
+  return lo;
+}
+
+// Everything a span holds fixed.
+struct SpanContext {
+  double dt = EconomyConfig::ECONOMY_TICK_RATE;
+  double fans = 0.0;
+  double fanListeners = 0.0; // Listening fans per unit of hype
+  double repBoost = 1.0;
+  double trust = 1.0;
+  double saturation = 1.0;
+  Genre trending = Genre::Mixed;
+  double trendMultiplier = 0.0;
+};
+
+// One release over ticks 1..n of a span. While above the long tail, its
+// streams at tick t are
+//   x(t) = h0 d^(t-1) (A + B g^(t-1)) K
+// (hype decay d, freshness step g), so every sum over a run of ticks is a
+// geometric series.
+struct ReleaseSpan {
+  // --- Model ---
+  double h0 = 0.0;
+  double decay = 1.0;       // d
+  double fanTerm = 0.0;     // A: fan listeners per unit of hype
+  double organicTerm = 0.0; // B: mean organic listeners at the first tick
+  double noiseTerm = 0.0;   // B's standard deviation (viral base)
+  double freshStep = 1.0;   // g
+  double scale = 0.0;       // K: demand * reputation boost
+  double salesChance = 0.0;
+
+  // --- Over the span ---
+  uint64_t active = 0; // Ticks it streams (alive, not expired)
+  uint64_t loud = 0;   // Leading active ticks above the long tail
+  bool expires = false;
+  double streams = 0.0;  // Expected over loud ticks (after truncation)
+  double variance = 0.0; // Viral noise over loud ticks
+  double sales = 0.0;
+  double hypeSum = 0.0; // Hype after each streaming tick (reputation)
+
+  // Mean streams at tick t >= 1 (while loud).
+  double Streams(uint64_t t) const {
+    double step = static_cast<double>(t - 1);
+    return h0 * std::pow(decay, step) *
+           (fanTerm + organicTerm * std::pow(freshStep, step)) * scale;
+  }
+};
+
+ReleaseSpan PrepareRelease(const ReleaseCatalog &catalog, size_t i,
+                           const SpanContext &ctx) {
+  const bool isAlbum = catalog.isAlbum;
+  const double quality = catalog.quality[i];
+  // Once per span, not per tick: always the exact curves
+  PerformanceCurve curve = EvaluatePerformanceCurve(
+      quality, catalog.price[i], isAlbum, CurveMode::Exact);
+
+  // Same trend rule and viral base as SimulateRange
+  double trend = (!isAlbum && catalog.genre[i] == ctx.trending)
+                     ? 1.0 + ctx.trendMultiplier
+                     : 1.0;
+  double firstFresh =
+      std::exp(-((catalog.lifeTime[i] + ctx.dt) / curve.decayTime));
+
+  ReleaseSpan span;
+  span.h0 = catalog.hype[i];
+  span.decay = HypeDecay(quality);
+  span.fanTerm = ctx.fanListeners;
+  span.organicTerm =
+      (isAlbum ? 150.0 : 50.0) * curve.qualityPower * trend * firstFresh;
+  span.noiseTerm = 15.0 * curve.qualityPower * trend * firstFresh;
+  span.freshStep = std::exp(-ctx.dt / curve.decayTime);
+  span.scale = curve.demand * ctx.repBoost;
+  span.salesChance = curve.salesChance;
+  return span;
+}
+
+// Fills the span sums of a prepared release for ticks 1..n.
+void EvaluateRelease(ReleaseSpan &span, float lifeTime, float maxLifeTime,
+                     uint64_t n, const SpanContext &ctx) {
+  // 1. Ticks it streams: hype above the dead line and not expired yet
+  uint64_t alive = CountLeading(n, [&](uint64_t t) {
+    return span.h0 * std::pow(span.decay, static_cast<double>(t - 1)) >
+           DEAD_HYPE;
+  });
+  uint64_t untilExpiry = TicksUntilExpiry(lifeTime, maxLifeTime, ctx.dt);
+  span.expires = untilExpiry <= n;
+  span.active = std::min({n, alive, untilExpiry});
+
+  // 2. Loud ticks first (x(t) only falls), then the long tail
+  span.loud = CountLeading(span.active, [&](uint64_t t) {
+    return span.Streams(t) >= TAIL_STREAMS;
+  });
+  const uint64_t tail = span.active - span.loud;
+
+  // 3. Closed-form sums over the loud ticks
+  const double stepBoth = span.decay * span.freshStep;
+  double fanRun = span.h0 * Geometric(span.decay, span.loud);
+  double organicRun = span.h0 * Geometric(stepBoth, span.loud);
+  double mean = (span.fanTerm * fanRun + span.organicTerm * organicRun) *
+                span.scale;
+  span.streams = std::max(0.0, mean - 0.5 * span.loud); // int() truncation
+
+  double noise = span.noiseTerm * span.scale * span.h0;
+  span.variance = noise * noise * Geometric(stepBoth * stepBoth, span.loud);
+
+  // 4. Sales = sum of floor(x(t) * chance), one sales level at a time
+  span.sales = 0.0;
+  for (double level = 1.0;; level += 1.0) {
+    uint64_t ticks = CountLeading(span.loud, [&](uint64_t t) {
+      return span.Streams(t) * span.salesChance >= level;
+    });
+    if (ticks == 0)
+      break;
+    span.sales += static_cast<double>(ticks);
+  }
+
+  // Tail ticks stream Int(0, 2): mean 1, and 2 in 3 of them stream at all
+  span.sales += tail *
+                (std::floor(span.salesChance) +
+                 std::floor(2.0 * span.salesChance)) /
+                3.0;
+  double tailHype = std::pow(span.decay, static_cast<double>(span.loud)) *
+                    Geometric(span.decay, tail);
+  span.hypeSum = span.h0 * span.decay *
+                 (Geometric(span.decay, span.loud) + tailHype * 2.0 / 3.0);
+}
+
+double ConversionChance(double quality) {
+  return ConversionCurve(quality, CurveMode::Exact);
+}
+
+double RepChangePerHype(double quality) {
+  if (quality >= 75.0)
+    return (quality - 70.0) * 0.005;
+  if (quality <= 45.0)
+    return -(50.0 - quality) * 0.02;
+  return 0.0;
+}
+
+// Streams a single shows at tick t (mean, long tail counted as 1) and the
+// standard deviation around it.
+void AddDailyStreams(const ReleaseSpan &span, uint64_t t, double &mean,
+                     double &variance) {
+  if (t > span.active)
+    return; // Dead or gone
+  if (t > span.loud) {
+    mean += 1.0;
+    variance += 1.0; // Covers Int(0, 2)
+    return;
+  }
+  double step = static_cast<double>(t - 1);
+  double noise = span.noiseTerm * span.scale * span.h0 *
+                 std::pow(span.decay * span.freshStep, step);
+  mean += span.Streams(t);
+  variance += noise * noise;
+}
+
+// Streams a single shows on the first tick of any span, as AddDailyStreams
+// gives once the span is evaluated. Only for releases alive at the start.
+void AddFirstTick(const ReleaseSpan &span, double &mean, double &variance) {
+  double streams = span.Streams(1);
+  if (streams < TAIL_STREAMS) {
+    mean += 1.0;
+    variance += 1.0;
+    return;
+  }
+  double noise = span.noiseTerm * span.scale * span.h0;
+  mean += streams;
+  variance += noise * noise;
+}
+
+// Fans churned over 'n' ticks at 'rate', with 'newFans' arriving evenly
+// (each tick adds its new fans before churn takes its cut).
+double SpanChurn(double fans, double newFans, double rate, uint64_t n) {
+  double lost = 0.0;
+  for (uint64_t t = 0; t < n; ++t) {
+    fans += newFans / n;
+    double cut = std::floor(fans * rate);
+    fans -= cut;
+    lost += cut;
+  }
+  return lost;
+}
+
+} // namespace
+
+uint64_t FastForwardEconomy(EconomyState &state, ReleaseCatalog &songs,
+                            ReleaseCatalog &albums, Player &player,
+                            uint64_t maxTicks, float &clock) {
+  constexpr float TICK = EconomyConfig::ECONOMY_TICK_RATE;
+
+  if (maxTicks == 0 || (songs.Empty() && albums.Empty()) ||
+      !state.market.initialized)
+    return 0;
+
+  // ...unless the caller asked for fewer ticks (Skip Week is 7)
+  const uint64_t minSpan = std::min(MIN_SPAN, maxTicks);
+
+  // -------------------------------------------------------------------------
+  // 1. SPAN LIMIT: next market shift
+  // -------------------------------------------------------------------------
+  // The clock is replayed float for float, as the ticks would add it
+  uint64_t n = 0;
+  for (float c = clock; n < maxTicks; ++n) {
+    c += TICK;
+    if (c >= TREND_DURATION)
+      break;
+  }
+  if (n < minSpan)
+    return 0;
+
+  // -------------------------------------------------------------------------
+  // 2. CHEAP REFUSALS (a few columns per release, nothing evaluated yet),
+  // THEN THE NEXT SCANDAL
+  // -------------------------------------------------------------------------
+  const double fans = player.fans;
+
+  // A release that had traction on the last tick all but surely has it on
+  // the next (the exact test in 4. only adds a noise margin to that)
+  for (const ReleaseCatalog *catalog : {&songs, &albums}) {
+    for (size_t i = 0; i < catalog->ActiveSize(); ++i) {
+      const double hype = catalog->hype[i];
+      const double quality = catalog->quality[i];
+      if (hype <= DEAD_HYPE)
+        continue; // Stays dead
+      if (catalog->dailyStreams[i] > TRACTION_STREAMS)
+        return 0;
+      if (quality > VIRAL_QUALITY && hype * HypeDecay(quality) > VIRAL_HYPE)
+        return 0;
+      if (quality < BACKLASH_QUALITY && fans > BACKLASH_FANS)
+        return 0;
+    }
+  }
+
+  // Scandals are one draw per tick from the churn stream, so the span can
+  // stop right before the next one (that tick then runs normally)
+  if (fans > BACKLASH_FANS) {
+    for (uint64_t t = 0; t < n; ++t) {
+      RandomStream churnRng(state.seed, RngStream::Churn, 0, state.tick + t);
+      if (churnRng.Chance(SCANDAL_CHANCE)) {
+        n = t;
+        break;
+      }
+    }
+  }
+  if (n < minSpan)
+    return 0;
+
+  // -------------------------------------------------------------------------
+  // 3. SPAN CONTEXT (player and market held fixed)
+  // -------------------------------------------------------------------------
+  const double reputation = player.reputation;
+  SpanContext ctx;
+  ctx.fans = fans;
+  ctx.fanListeners = fans * std::clamp(reputation / 1000.0, 0.05, 0.40);
+  ctx.repBoost = 1.0 + (std::log10(std::max(1.0, reputation)) * 0.1);
+  ctx.trust = 1.0 + (reputation / 200.0);
+  if (fans > 1000000) {
+    ctx.saturation = std::clamp(1.0 / (std::log10(fans) - 3.0), 0.01, 1.0);
+  }
+  ctx.trending = state.market.genre;
+  ctx.trendMultiplier = state.market.multiplier;
+
+  // -------------------------------------------------------------------------
+  // 4. TRACTION WITH ITS NOISE MARGIN, AND THE FIRST TICK
+  // -------------------------------------------------------------------------
+  // Reused between spans
+  thread_local std::vector<ReleaseSpan> songSpans;
+  thread_local std::vector<ReleaseSpan> albumSpans;
+
+  const double fanCeiling = fans + std::max(FAN_DRIFT * fans, MIN_FAN_DRIFT);
+  const double ceilingListeners =
+      fanCeiling * std::clamp(reputation / 1000.0, 0.05, 0.40);
+
+  // The first tick is part of every span, and streams only fall after it
+  double firstFans = 0.0;                 // New fans on the first tick
+  double firstMean = 0.0, firstVar = 0.0; // Singles' streams on it
+
+  for (ReleaseCatalog *catalog : {&songs, &albums}) {
+    std::vector<ReleaseSpan> &spans = catalog->isAlbum ? albumSpans : songSpans;
+    spans.resize(catalog->Size());
+
+    for (size_t i = 0; i < catalog->Size(); ++i) {
+      ReleaseSpan &span = spans[i];
+      if (i >= catalog->ActiveSize()) {
+        span = ReleaseSpan{}; // Dormant: only ages
+        span.h0 = catalog->hype[i];
+        continue;
+      }
+
+      span = PrepareRelease(*catalog, i, ctx);
+      if (span.h0 <= DEAD_HYPE)
+        continue; // Stays dead
+
+      // Streams only fall within a span, so the first tick is the peak
+      double peak = span.h0 *
+                    (ceilingListeners + span.organicTerm +
+                     NOISE_SIGMAS * span.noiseTerm) *
+                    span.scale;
+      if (peak >= TRACTION_STREAMS)
+        return 0;
+
+      double tickMean = 0.0, tickVar = 0.0;
+      AddFirstTick(span, tickMean, tickVar);
+      firstFans += tickMean * ConversionChance(catalog->quality[i]) *
+                   ctx.trust * ctx.saturation;
+      if (!catalog->isAlbum) { // The inactivity rule only counts singles
+        firstMean += tickMean;
+        firstVar += tickVar;
+      }
+    }
+  }
+
+  // a) Inactivity: a span needs every tick on one side of the line. If the
+  // first tick is undecided, so is every span
+  double churnRate = 0.0;
+  if (fans > 100000)
+    churnRate = 0.0005;
+  else if (fans > CHURN_FANS)
+    churnRate = 0.0002;
+
+  const double firstHigh = firstMean + NOISE_SIGMAS * std::sqrt(firstVar);
+  const double firstLow = firstMean - NOISE_SIGMAS * std::sqrt(firstVar);
+  const bool inactive = firstHigh < INACTIVE_STREAMS;
+  if (churnRate > 0.0 && !inactive && firstLow < INACTIVE_STREAMS)
+    return 0;
+  if (churnRate > 0.0 && inactive)
+    churnRate *= 2.0;
+
+  // b) Fans: every tick gains at most what the first one does, so a span
+  // longer than 'fit' ticks may leave the band or drift too far. If even
+  // the first tick leaves the band, no span is short enough
+  const double drift = std::max(FAN_DRIFT * fans, MIN_FAN_DRIFT);
+  const double firstLost = SpanChurn(fans, firstFans, churnRate, 1);
+  if (FanBand(fans + firstFans) != FanBand(fans) ||
+      FanBand(fans - firstLost) != FanBand(fans))
+    return 0;
+  if (firstFans > 0.0) {
+    double fit = std::floor(std::min(drift, BandRoom(fans)) / firstFans);
+    if (fit < static_cast<double>(n))
+      n = static_cast<uint64_t>(fit);
+  }
+  if (n < minSpan)
+    return 0;
+
+  // -------------------------------------------------------------------------
+  // 5. SHRINK UNTIL THE FANBASE AND THE CHURN RULE HOLD STILL
+  // -------------------------------------------------------------------------
+  double newFans = 0.0;
+  double lost = 0.0;
+  for (; n >= minSpan; n /= 2) {
+    newFans = 0.0;
+    double lastMean = 0.0, lastVar = 0.0;
+
+    for (ReleaseCatalog *catalog : {&songs, &albums}) {
+      std::vector<ReleaseSpan> &spans =
+          catalog->isAlbum ? albumSpans : songSpans;
+      float maxLife = catalog->isAlbum ? EconomyConfig::ALBUM_LIFETIME
+                                       : EconomyConfig::SONG_LIFETIME;
+
+      // Dormant releases stream nothing; they only need their expiry
+      for (size_t i = catalog->ActiveSize(); i < catalog->Size(); ++i) {
+        spans[i].expires =
+            TicksUntilExpiry(catalog->lifeTime[i], maxLife, ctx.dt) <= n;
+      }
+
+      for (size_t i = 0; i < catalog->ActiveSize(); ++i) {
+        ReleaseSpan &span = spans[i];
+        EvaluateRelease(span, catalog->lifeTime[i], maxLife, n, ctx);
+
+        double streams = span.streams + (span.active - span.loud);
+        newFans += streams * ConversionChance(catalog->quality[i]) *
+                   ctx.trust * ctx.saturation;
+        if (!catalog->isAlbum)
+          AddDailyStreams(span, n, lastMean, lastVar);
+      }
+    }
+
+    // a) An active fanbase must stay active to the last tick
+    if (churnRate > 0.0 && !inactive &&
+        lastMean - NOISE_SIGMAS * std::sqrt(lastVar) < INACTIVE_STREAMS)
+      continue;
+    lost = SpanChurn(fans, newFans, churnRate, n);
+
+    // b) Fans may only drift a little and must stay in their band
+    double fanLow = fans - lost;
+    double fanHigh = fans + newFans;
+    if (FanBand(fanLow) != FanBand(fans) || FanBand(fanHigh) != FanBand(fans))
+      continue;
+    if (std::fabs(newFans - lost) > drift)
+      continue;
+    break;
+  }
+  if (n < minSpan)
+    return 0;
+
+  // -------------------------------------------------------------------------
+  // 6. APPLY (one aggregate draw per release)
+  // -------------------------------------------------------------------------
+  const uint64_t firstTick = state.tick;
+  double revenueTotal = 0.0;
+  double repChange = 0.0;
+  long long fanGain = 0;
+
+  for (ReleaseCatalog *catalog : {&songs, &albums}) {
+    std::vector<ReleaseSpan> &spans = catalog->isAlbum ? albumSpans : songSpans;
+    float maxLife = catalog->isAlbum ? EconomyConfig::ALBUM_LIFETIME
+                                     : EconomyConfig::SONG_LIFETIME;
+
+    for (size_t i = 0; i < catalog->Size(); ++i) {
+      const ReleaseSpan &span = spans[i];
+
+      // Every release ages, streaming or not
+      catalog->lifeTime[i] += static_cast<float>(n * ctx.dt);
+      if (span.expires)
+        catalog->lifeTime[i] = std::max(catalog->lifeTime[i], maxLife);
+
+      if (span.active == 0) {
+        if (span.h0 <= DEAD_HYPE)
+          catalog->dailyStreams[i] = 0;
+        continue;
+      }
+
+      RandomStream rng(state.seed, RngStream::FastForward,
+                       uint64_t{catalog->id[i]} * 2 + catalog->isAlbum,
+                       firstTick);
+
+      // a) Streams: loud ticks ~ Normal(sum), tail ticks ~ sum of Int(0, 2)
+      double streams = span.streams;
+      if (span.variance > 0.0)
+        streams += std::sqrt(span.variance) * rng.Normal(0.0, 1.0);
+      streams = std::max(0.0, streams);
+
+      const double tail = static_cast<double>(span.active - span.loud);
+      if (tail > 0.0) {
+        double tailStreams = tail + std::sqrt(tail * 2.0 / 3.0) *
+                                        rng.Normal(0.0, 1.0);
+        streams += std::clamp(tailStreams, 0.0, 2.0 * tail);
+      }
+      long long totalStreams = std::llround(streams);
+
+      // b) Sales and revenue
+      long long sales =
+          std::min(std::llround(span.sales), totalStreams);
+      double revenue = (totalStreams * EconomyConfig::STREAM_PAYOUT_RATE) +
+                       (sales * catalog->price[i]);
+
+      // c) Fans: probabilistic rounding of the span's total, like the tick
+      // does for each tick's fraction
+      double fanMean = totalStreams * ConversionChance(catalog->quality[i]) *
+                       ctx.trust * ctx.saturation;
+      double wholeFans = std::floor(fanMean);
+      fanGain += static_cast<long long>(wholeFans) +
+                 (rng.Chance(fanMean - wholeFans) ? 1 : 0);
+      repChange += RepChangePerHype(catalog->quality[i]) * span.hypeSum;
+
+      // d) Release state after the last tick
+      catalog->totalStreams[i] += static_cast<int>(totalStreams);
+      catalog->totalSales[i] += static_cast<int>(sales);
+      catalog->earnings[i] += revenue;
+      revenueTotal += revenue;
+
+      double hype = span.h0 * std::pow(span.decay,
+                                       static_cast<double>(span.active));
+      catalog->hype[i] = std::clamp(hype, 0.0, 10.0);
+
+      if (span.active < n)
+        catalog->dailyStreams[i] = 0; // Died (or expired) inside the span
+      else if (span.loud == n)
+        catalog->dailyStreams[i] = static_cast<int>(span.Streams(n));
+      else
+        catalog->dailyStreams[i] = 1; // Long tail
+    }
+  }
+
+  // -------------------------------------------------------------------------
+  // 7. PLAYER & BOOKKEEPING
+  // -------------------------------------------------------------------------
+  player.money += revenueTotal;
+  player.reputation = std::clamp(reputation + repChange, 0.0, 1000.0);
+  long long finalFans = static_cast<long long>(fans) + fanGain -
+                        static_cast<long long>(lost);
+  player.fans = static_cast<int>(
+      std::clamp(finalFans, 0LL, static_cast<long long>(INT_MAX)));
+
+  // Not a no-op: in float, (a + TICK) - TICK need not equal a. Each tick
+  // does exactly this to the accumulator (SimulateEconomy's += dt, then
+  // -= ECONOMY_TICK_RATE), so it is repeated for its rounding, as the clock
+  // is, to end the span where the ticks would have left both
+  for (uint64_t t = 0; t < n; ++t) {
+    clock += TICK;
+    state.accumulator += TICK;
+    state.accumulator -= TICK;
+  }
+  state.tick += n;
+
+  // One telemetry row for the whole span: its last tick, marked with the
+  // number of ticks it stands for (see telemetry.h)
+  if (state.telemetry) {
+    long long dailyStreams = 0;
+    for (const ReleaseCatalog *catalog : {&songs, &albums}) {
+      for (int daily : catalog->dailyStreams)
+        dailyStreams += daily;
+    }
+
+    TelemetryRow row;
+    row.tick = state.tick - 1;
+    row.money = player.money;
+    row.reputation = player.reputation;
+    row.dailyStreams = dailyStreams;
+    row.fans = player.fans;
+    row.songs = static_cast<uint32_t>(songs.Size());
+    row.albums = static_cast<uint32_t>(albums.Size());
+    row.ticksCovered = static_cast<uint32_t>(std::min<uint64_t>(n, UINT32_MAX));
+    row.trendMultiplier = state.market.multiplier;
+    row.trendGenre = static_cast<uint8_t>(state.market.genre);
+    state.telemetry->Append(row);
+  }
+
+  // Releases whose hype ran out inside the span
+  songs.DemoteDead();
+  albums.DemoteDead();
+  return n;
+}
+
+// ----------------------------------------------------------------------------
+// RELEASE FORECAST
+// ----------------------------------------------------------------------------
+
+double ExpectedAlbumEarnings(double quality, const Player &player) {
+  const double tick = EconomyConfig::ECONOMY_TICK_RATE;
+  const double price = GetRecommendedPrice(quality, true);
+  const CurveMode curves = GetCurveMode();
+  const PerformanceCurve curve =
+      EvaluatePerformanceCurve(quality, price, true, curves);
+
+  // Same terms as SimulateRange, for a fanbase that holds still
+  const double reputation = player.reputation;
+  const double fanListeners =
+      player.fans * std::clamp(reputation / 1000.0, 0.05, 0.40);
+  const double repBoost = 1.0 + (std::log10(std::max(1.0, reputation)) * 0.1);
+  const double naturalDecay = (quality > 85.0) ? 0.995 : 0.97;
+  const double viralBase = 150.0; // Mean of the album draw, Normal(150, 15)
+
+  // Streams every tick until the hype dies or the lifetime runs out
+  double hype = 1.0 + (player.fans * 0.001); // As Album's constructor
+  double earnings = 0.0;
+  const int ticks =
+      static_cast<int>(std::ceil(EconomyConfig::ALBUM_LIFETIME / tick));
+  for (int t = 1; t <= ticks && hype > ReleaseCatalog::DEAD_HYPE; ++t) {
+    double fresh = FreshnessCurve((t * tick) / curve.decayTime, curves);
+    double organic = viralBase * curve.qualityPower * fresh * hype;
+    double streams = std::floor((fanListeners * hype + organic) *
+                                curve.demand * repBoost);
+
+    double sales;
+    if (streams < 5.0) {
+      // Long tail: Int(0, 2) streams, 1 on average
+      streams = 1.0;
+      sales = (std::floor(curve.salesChance) +
+               std::floor(2.0 * curve.salesChance)) /
+              3.0;
+    } else {
+      sales = std::floor(streams * curve.salesChance);
+    }
+    earnings += streams * EconomyConfig::STREAM_PAYOUT_RATE + sales * price;
+
+    double restoration = (streams > 1000.0) ? 0.005 : 0.0;
+    hype = std::clamp(hype * (naturalDecay + restoration), 0.0, 10.0);
+  }
+  return earnings;
+}
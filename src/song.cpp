@@ -1,9 +1,14 @@
 #include "../headers/song.h"
 
-Song::Song(std::string _name, std::string _artist, std::string _genre,
+Song::Song(std::string_view _name, std::string_view _artist, Genre _genre,
            double _quality, int _fans, double _price)
-    : name(_name), artist(_artist), genre(_genre), quality(_quality),
-      fansAtRelease(_fans), price(_price) {
+    : Song(stringPool.Intern(_name), stringPool.Intern(_artist), _genre,
+           _quality, _fans, _price) {}
+
+Song::Song(StringId _name, StringId _artist, Genre _genre, double _quality,
+           int _fans, double _price)
+    : name(_name), artist(_artist), genre(_genre), price(_price),
+      quality(_quality), fansAtRelease(_fans) {
   // Calculate initial hype based on quality and existing fans
   hype = 1.0 + (quality / 100.0) + (fansAtRelease / 50000.0);
-}
\ No newline at end of file
+}
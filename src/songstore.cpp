@@ -0,0 +1,39 @@
+#include "../headers/songstore.h"
+
+#include <algorithm>
+
+SongId SongStore::Add(const Song &song) {
+  if (!freeIds.empty()) {
+    SongId id = freeIds.back();
+    freeIds.pop_back();
+    songs[id] = song;
+    return id;
+  }
+  songs.push_back(song);
+  return static_cast<SongId>(songs.size() - 1);
+}
+
+void SongStore::Remove(SongId id) {
+  freeIds.push_back(id);
+  if (freeIds.size() == songs.size())
+    Clear(); // Last live track gone: start over compact
+}
+
+void SongStore::Clear() {
+  songs.clear();
+  freeIds.clear();
+}
+
+void SongStore::Attribute(const std::vector<SongId> &tracks, double total,
+                          std::vector<double> &out) const {
+  out.assign(tracks.size(), 0.0);
+
+  // Every track gets some plays, even a 0-quality one
+  double weightSum = 0.0;
+  for (size_t k = 0; k < tracks.size(); ++k) {
+    out[k] = std::max(songs[tracks[k]].quality, 1.0);
+    weightSum += out[k];
+  }
+  for (double &share : out)
+    share = total * share / weightSum;
+}
@@ -0,0 +1,64 @@
+#include "../headers/stringpool.h"
+
+#include <cstring>
+
+StringPool stringPool;
+
+StringPool::StringPool() { Intern(""); }
+
+const char *StringPool::Store(std::string_view text) {
+  size_t size = text.size() + 1;
+  char *out;
+  if (size > CHUNK_BYTES) {
+    // Oversized: a chunk of its own (the current one stays open)
+    chunks.push_back(std::make_unique<char[]>(size));
+    out = chunks.back().get();
+  } else {
+    if (!chunk || chunkUsed + size > CHUNK_BYTES) {
+      chunks.push_back(std::make_unique<char[]>(CHUNK_BYTES));
+      chunk = chunks.back().get();
+      chunkUsed = 0;
+    }
+    out = chunk + chunkUsed;
+    chunkUsed += size;
+  }
+
+  if (!text.empty())
+    std::memcpy(out, text.data(), text.size());
+  out[text.size()] = '\0';
+  bytes += size;
+  return out;
+}
+
+StringId StringPool::Intern(std::string_view text) {
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = ids.find(text);
+  if (it != ids.end())
+    return it->second;
+
+  uint32_t id = count.load(std::memory_order_relaxed);
+  size_t segment = id / SEGMENT_SIZE;
+  if (segment >= MAX_SEGMENTS)
+    return 0; // Full: degrade to the empty name rather than fail the tick
+  if (!segments[segment])
+    segments[segment] = std::make_unique<std::string_view[]>(SEGMENT_SIZE);
+
+  std::string_view stored(Store(text), text.size());
+  segments[segment][id % SEGMENT_SIZE] = stored;
+  ids.emplace(stored, id);
+
+  // Publish: readers that see the new count also see the entry
+  count.store(id + 1, std::memory_order_release);
+  return id;
+}
+
+std::string_view StringPool::View(StringId id) const {
+  if (id >= count.load(std::memory_order_acquire))
+    return "";
+  return segments[id / SEGMENT_SIZE][id % SEGMENT_SIZE];
+}
+
+size_t StringPool::Bytes() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return bytes;
+}
@@ -0,0 +1,314 @@
+#include "../headers/telemetry.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr char MAGIC[8] = {'M', 'T', 'Y', 'C', 'T', 'L', 'M', '\0'};
+
+// How each TelemetryRow field becomes a column
+struct ColumnSpec {
+  const char *name;
+  TelemetryType type;
+  size_t offset;
+  size_t size;
+};
+
+const ColumnSpec COLUMNS[] = {
+    {"tick", TelemetryType::U64, offsetof(TelemetryRow, tick),
+     sizeof(TelemetryRow::tick)},
+    {"money", TelemetryType::F64, offsetof(TelemetryRow, money),
+     sizeof(TelemetryRow::money)},
+    {"reputation", TelemetryType::F64, offsetof(TelemetryRow, reputation),
+     sizeof(TelemetryRow::reputation)},
+    {"dailyStreams", TelemetryType::I64, offsetof(TelemetryRow, dailyStreams),
+     sizeof(TelemetryRow::dailyStreams)},
+    {"fans", TelemetryType::I32, offsetof(TelemetryRow, fans),
+     sizeof(TelemetryRow::fans)},
+    {"songs", TelemetryType::U32, offsetof(TelemetryRow, songs),
+     sizeof(TelemetryRow::songs)},
+    {"albums", TelemetryType::U32, offsetof(TelemetryRow, albums),
+     sizeof(TelemetryRow::albums)},
+    {"ticksCovered", TelemetryType::U32, offsetof(TelemetryRow, ticksCovered),
+     sizeof(TelemetryRow::ticksCovered)},
+    {"trendMultiplier", TelemetryType::F32,
+     offsetof(TelemetryRow, trendMultiplier),
+     sizeof(TelemetryRow::trendMultiplier)},
+    {"trendGenre", TelemetryType::U8, offsetof(TelemetryRow, trendGenre),
+     sizeof(TelemetryRow::trendGenre)},
+    {"reputationCycle", TelemetryType::U8,
+     offsetof(TelemetryRow, reputationCycle),
+     sizeof(TelemetryRow::reputationCycle)},
+};
+
+constexpr size_t COLUMN_COUNT = sizeof(COLUMNS) / sizeof(COLUMNS[0]);
+
+constexpr size_t Align8(size_t value) { return (value + 7) & ~size_t{7}; }
+
+} // namespace
+
+TelemetryRecorder::~TelemetryRecorder() { Close(); }
+
+bool TelemetryRecorder::Open(const std::string &path, std::string &error) {
+  Close();
+
+  file = std::fopen(path.c_str(), "wb");
+  if (!file) {
+    error = "Cannot open " + path + " for writing";
+    return false;
+  }
+
+  // 1. File header + column table
+  TelemetryFileHeader header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.columnCount = static_cast<uint32_t>(COLUMN_COUNT);
+  bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+
+  for (const ColumnSpec &spec : COLUMNS) {
+    TelemetryColumn column{};
+    std::snprintf(column.name, sizeof(column.name), "%s", spec.name);
+    column.type = static_cast<uint32_t>(spec.type);
+    column.size = static_cast<uint32_t>(spec.size);
+    ok = ok && std::fwrite(&column, sizeof(column), 1, file) == 1;
+  }
+  if (!ok || std::fflush(file) != 0) {
+    std::fclose(file);
+    file = nullptr;
+    error = "Failed writing " + path;
+    return false;
+  }
+
+  // 2. Everything the recorder will ever need, allocated once
+  ring.assign(RING_BLOCKS * BLOCK_ROWS, TelemetryRow{});
+  columnScratch.assign(Align8(BLOCK_ROWS * sizeof(uint64_t)), 0);
+
+  currentBlock = 0;
+  rowInBlock = 0;
+  nextToWrite = 0;
+  stopping = false;
+  failed = false;
+  for (size_t b = 0; b < RING_BLOCKS; ++b) {
+    busy[b] = false;
+    blockRows[b] = 0;
+  }
+  rowsWritten = 0;
+
+  writer = std::thread([this] { WriterLoop(); });
+  return true;
+}
+
+bool TelemetryRecorder::Close() {
+  if (!file)
+    return true;
+
+  // Hand the partial block over, then let the writer drain and exit
+  if (rowInBlock > 0)
+    SubmitCurrentBlock();
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wake.notify_all();
+  writer.join();
+
+  bool ok = !failed;
+  ok = std::fclose(file) == 0 && ok;
+  file = nullptr;
+  return ok;
+}
+
+void TelemetryRecorder::Append(const TelemetryRow &row) {
+  // The previous block is handed off lazily, so the last row stays writable
+  // for NoteReputation until the next tick.
+  if (rowInBlock == BLOCK_ROWS)
+    SubmitCurrentBlock();
+
+  ring[currentBlock * BLOCK_ROWS + rowInBlock] = row;
+  ++rowInBlock;
+}
+
+void TelemetryRecorder::NoteReputation(double reputation) {
+  if (rowInBlock == 0)
+    return; // No tick recorded yet
+
+  TelemetryRow &row = ring[currentBlock * BLOCK_ROWS + rowInBlock - 1];
+  row.reputation = reputation;
+  row.reputationCycle = 1;
+}
+
+void TelemetryRecorder::SubmitCurrentBlock() {
+  std::unique_lock<std::mutex> lock(mutex);
+  busy[currentBlock] = true;
+  blockRows[currentBlock] = rowInBlock;
+  wake.notify_one();
+
+  // Move on; only wait if the writer is a full ring behind
+  currentBlock = (currentBlock + 1) % RING_BLOCKS;
+  rowInBlock = 0;
+  freed.wait(lock, [&] { return !busy[currentBlock]; });
+}
+
+void TelemetryRecorder::WriterLoop() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    wake.wait(lock, [&] { return stopping || busy[nextToWrite]; });
+    if (!busy[nextToWrite])
+      return; // Stopping and drained
+
+    size_t block = nextToWrite;
+    size_t rows = blockRows[block];
+    lock.unlock();
+    bool ok = WriteBlock(block, rows);
+    lock.lock();
+
+    failed = failed || !ok;
+    busy[block] = false;
+    nextToWrite = (nextToWrite + 1) % RING_BLOCKS;
+    freed.notify_one();
+  }
+}
+
+bool TelemetryRecorder::WriteBlock(size_t block, size_t rows) {
+  const TelemetryRow *first = &ring[block * BLOCK_ROWS];
+
+  TelemetryBlockHeader header{};
+  header.magic = BLOCK_MAGIC;
+  header.rowCount = static_cast<uint32_t>(rows);
+  header.firstTick = first->tick;
+  bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+
+  // Transpose one column at a time into the scratch buffer
+  for (const ColumnSpec &spec : COLUMNS) {
+    unsigned char *out = columnScratch.data();
+    for (size_t r = 0; r < rows; ++r) {
+      std::memcpy(out + r * spec.size,
+                  reinterpret_cast<const unsigned char *>(first + r) +
+                      spec.offset,
+                  spec.size);
+    }
+    size_t bytes = Align8(rows * spec.size);
+    std::memset(out + rows * spec.size, 0, bytes - rows * spec.size);
+    ok = ok && std::fwrite(out, 1, bytes, file) == bytes;
+  }
+
+  // Large blocks, so flushing each one keeps the file readable mid-run
+  ok = ok && std::fflush(file) == 0;
+  if (ok)
+    rowsWritten += rows;
+  return ok;
+}
+
+bool DumpTelemetryCsv(const std::string &path, std::FILE *out,
+                      std::string &error) {
+  std::FILE *in = std::fopen(path.c_str(), "rb");
+  if (!in) {
+    error = "Cannot open " + path;
+    return false;
+  }
+
+  // 1. Header and column table
+  TelemetryFileHeader header{};
+  bool ok = std::fread(&header, sizeof(header), 1, in) == 1 &&
+            std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 &&
+            header.version <= TelemetryRecorder::VERSION &&
+            header.columnCount > 0 && header.columnCount < 256;
+  std::vector<TelemetryColumn> columns(ok ? header.columnCount : 0);
+  for (TelemetryColumn &column : columns) {
+    ok = ok && std::fread(&column, sizeof(column), 1, in) == 1 &&
+         column.size > 0 && column.size <= 8;
+    column.name[sizeof(column.name) - 1] = '\0';
+  }
+  if (!ok) {
+    std::fclose(in);
+    error = path + " is not a telemetry file";
+    return false;
+  }
+
+  for (size_t c = 0; c < columns.size(); ++c)
+    std::fprintf(out, "%s%s", c ? "," : "", columns[c].name);
+  std::fprintf(out, "\n");
+
+  // 2. Blocks (a truncated final block from a crashed run is ignored)
+  std::vector<std::vector<unsigned char>> data(columns.size());
+  TelemetryBlockHeader block{};
+  while (std::fread(&block, sizeof(block), 1, in) == 1) {
+    if (block.magic != TelemetryRecorder::BLOCK_MAGIC) {
+      std::fclose(in);
+      error = "Corrupt telemetry block";
+      return false;
+    }
+
+    bool complete = true;
+    for (size_t c = 0; c < columns.size() && complete; ++c) {
+      data[c].resize(Align8(block.rowCount * columns[c].size));
+      complete = std::fread(data[c].data(), 1, data[c].size(), in) ==
+                 data[c].size();
+    }
+    if (!complete)
+      break;
+
+    for (uint32_t r = 0; r < block.rowCount; ++r) {
+      for (size_t c = 0; c < columns.size(); ++c) {
+        const unsigned char *value = data[c].data() + r * columns[c].size;
+        if (c)
+          std::fputc(',', out);
+
+        switch (static_cast<TelemetryType>(columns[c].type)) {
+        case TelemetryType::U8:
+          std::fprintf(out, "%u", static_cast<unsigned>(*value));
+          break;
+        case TelemetryType::I32: {
+          int32_t v;
+          std::memcpy(&v, value, sizeof(v));
+          std::fprintf(out, "%d", v);
+          break;
+        }
+        case TelemetryType::U32: {
+          uint32_t v;
+          std::memcpy(&v, value, sizeof(v));
+          std::fprintf(out, "%u", v);
+          break;
+        }
+        case TelemetryType::I64: {
+          int64_t v;
+          std::memcpy(&v, value, sizeof(v));
+          std::fprintf(out, "%lld", static_cast<long long>(v));
+          break;
+        }
+        case TelemetryType::U64: {
+          uint64_t v;
+          std::memcpy(&v, value, sizeof(v));
+          std::fprintf(out, "%llu", static_cast<unsigned long long>(v));
+          break;
+        }
+        case TelemetryType::F32: {
+          float v;
+          std::memcpy(&v, value, sizeof(v));
+          std::fprintf(out, "%.6g", v);
+          break;
+        }
+        case TelemetryType::F64: {
+          double v;
+          std::memcpy(&v, value, sizeof(v));
+          std::fprintf(out, "%.17g", v);
+          break;
+        }
+        default:
+          std::fprintf(out, "?");
+          break;
+        }
+      }
+      std::fputc('\n', out);
+    }
+  }
+
+  std::fclose(in);
+  return true;
+}
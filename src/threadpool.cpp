@@ -0,0 +1,94 @@
+#include "../headers/threadpool.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace {
+// True while this thread is running pool tasks (nested calls run inline)
+thread_local bool insideTask = false;
+} // namespace
+
+ThreadPool::ThreadPool(size_t threadCount) {
+  if (threadCount == 0)
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+  for (size_t i = 1; i < threadCount; ++i)
+    workers.emplace_back([this] { WorkerLoop(); });
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wake.notify_all();
+  for (auto &worker : workers)
+    worker.join();
+}
+
+void ThreadPool::RunTasks() {
+  bool wasInside = insideTask;
+  insideTask = true;
+  for (size_t task = nextTask.fetch_add(1); task < jobSize;
+       task = nextTask.fetch_add(1)) {
+    (*job)(task);
+  }
+  insideTask = wasInside;
+}
+
+void ThreadPool::WorkerLoop() {
+  size_t seenGeneration = 0;
+  std::unique_lock<std::mutex> lock(mutex);
+
+  while (true) {
+    wake.wait(lock,
+              [&] { return stopping || generation != seenGeneration; });
+    if (stopping)
+      return;
+    seenGeneration = generation;
+
+    lock.unlock();
+    RunTasks();
+    lock.lock();
+
+    if (--pendingWorkers == 0)
+      done.notify_all();
+  }
+}
+
+void ThreadPool::ParallelFor(size_t taskCount,
+                             const std::function<void(size_t)> &fn) {
+  if (taskCount == 0)
+    return;
+
+  // 1. Nothing to share: run inline
+  if (workers.empty() || taskCount == 1 || insideTask) {
+    for (size_t task = 0; task < taskCount; ++task)
+      fn(task);
+    return;
+  }
+
+  // 2. Publish the job and wake everyone
+  std::lock_guard<std::mutex> jobLock(jobMutex);
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    job = &fn;
+    jobSize = taskCount;
+    nextTask.store(0);
+    pendingWorkers = workers.size();
+    ++generation;
+  }
+  wake.notify_all();
+
+  // 3. Help out, then wait for the stragglers
+  RunTasks();
+
+  std::unique_lock<std::mutex> lock(mutex);
+  done.wait(lock, [&] { return pendingWorkers == 0; });
+  job = nullptr;
+}
+
+ThreadPool &SharedThreadPool() {
+  static ThreadPool pool;
+  return pool;
+}
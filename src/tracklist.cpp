@@ -0,0 +1,348 @@
+#include "../headers/tracklist.h"
+#include "../headers/albumquality.h"
+#include "../headers/threadpool.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <mutex>
+#include <numeric>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr uint64_t DEADLINE_CHECK = 4096; // Nodes between clock reads
+constexpr double MAX_QUALITY = 100.0;     // AlbumSoftCap's ceiling
+
+// Bounds are summed in another order than the albums they bound, so they
+// may come out this much too low; a branch is only cut when it is short by
+// more than that.
+constexpr double BOUND_SLACK = 1e-9;
+
+// Candidates ranked best first, shared by every search.
+struct Ranking {
+  std::vector<uint32_t> candidate; // Rank -> candidate index
+  std::vector<double> value;       // Rank -> quality
+  std::vector<double> prefix;      // prefix[r] = value[0] + ... + value[r-1]
+  std::vector<uint32_t> nextValue; // First rank after r with another value
+};
+
+// Best tracklist found so far, across sizes and threads.
+struct Incumbent {
+  std::atomic<double> quality{0.0};
+  std::mutex mutex;
+  std::vector<uint32_t> ranks;
+
+  void Offer(double q, const uint32_t *picks, size_t count) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (q <= quality.load(std::memory_order_relaxed))
+      return;
+    ranks.assign(picks, picks + count);
+    quality.store(q, std::memory_order_relaxed);
+  }
+};
+
+// Whether a branch with this bound may still beat the best tracklist.
+bool Promising(const Incumbent &best, double bound) {
+  double current = best.quality.load(std::memory_order_relaxed);
+  return current < MAX_QUALITY && bound + BOUND_SLACK > current;
+}
+
+// Shared stop state: the wall-time budget.
+struct Deadline {
+  Clock::time_point end;
+  std::atomic<bool> expired{false};
+};
+
+// Depth-first search for one track count. One per thread and size; picks
+// are added in rank order, so they are always sorted best first.
+class SizeSearch {
+public:
+  SizeSearch(const Ranking &ranking, size_t tracks, Incumbent &best,
+             Deadline &deadline)
+      : ranking(ranking), k(tracks), best(best), deadline(deadline) {
+    size_t head = std::min(k, ALBUM_HEAD);
+    for (size_t p = 0; p < head; ++p)
+      totalWeight += ALBUM_WEIGHTS[p];
+    totalWeight += static_cast<double>(k - head) * ALBUM_TAIL_WEIGHT;
+  }
+
+  // Highest quality any tracklist can reach that keeps the current picks,
+  // skips every rank before 'r' and fills the rest from 'r' on.
+  double Bound(size_t r) const {
+    const size_t n = ranking.value.size();
+    const size_t open = k - count;
+
+    // 1. Weighted base: the next 'open' ranks are the best fill for every
+    // spot at once (later picks can only be lower), the last ones the worst
+    double base = Base(r, open) / totalWeight;
+    double lowestBase = Base(n - open, open) / totalWeight;
+
+    // 2. Spread: the picks' own squared deviations, plus the least the
+    // open spots can add (all of them as close to the picks as allowed,
+    // i.e. at value[r])
+    double stdev = 0.0;
+    if (count > 0 && k > 1) {
+      double c = static_cast<double>(count);
+      double mean = sum / c;
+      double ownSquares = std::max(0.0, sumSquares - sum * mean);
+      double gap = std::max(0.0, mean - ranking.value[r]);
+      double squares = ownSquares + c * static_cast<double>(open) /
+                                        static_cast<double>(k) * gap * gap;
+      stdev = std::sqrt(squares / static_cast<double>(k - 1));
+    }
+
+    // 3. Filler: the threshold is at least its share of the lowest base, so
+    // at least the picks below that are filler, and so are the open spots
+    // that cannot all be filled from above it
+    double penalty = 0.0;
+    if (k >= ALBUM_FILLER_MIN_TRACKS && lowestBase > ALBUM_FILLER_MIN_BASE) {
+      double threshold = lowestBase * ALBUM_FILLER_SHARE;
+      size_t filler = 0;
+      for (size_t p = count; p-- > 0 && ranking.value[picks[p]] < threshold;)
+        ++filler;
+      size_t above = RanksAbove(r, threshold);
+      if (open > above)
+        filler += open - above;
+      if (filler > static_cast<double>(k) * 0.25)
+        penalty = static_cast<double>(filler) * 2.0;
+    }
+
+    return AlbumSoftCap(base + AlbumCohesion(stdev) + AlbumLengthBonus(k) -
+                        penalty);
+  }
+
+  // Explores every tracklist whose best pick is rank 'first'.
+  void SearchFrom(size_t first) {
+    Push(first);
+    Descend(first + 1);
+    Pop();
+  }
+
+  // The top 'k' candidates: a tracklist to beat before the search starts.
+  void Greedy() {
+    for (size_t r = 0; r < k; ++r)
+      Push(r);
+    Evaluate();
+    while (count > 0)
+      Pop();
+  }
+
+  bool CanStart(size_t first) const {
+    return first + k <= ranking.value.size() && Promising(best, Bound(first));
+  }
+
+
+  uint64_t Nodes() const { return nodes; }
+
+private:
+  double Best() const { return best.quality.load(std::memory_order_relaxed); }
+
+  // Weighted sum of the picks plus ranks [from, from + open) in the open
+  // spots.
+  double Base(size_t from, size_t open) const {
+    double weighted = headWeighted + tailSum * ALBUM_TAIL_WEIGHT;
+    size_t j = 0;
+    for (; j < open && count + j < ALBUM_HEAD; ++j)
+      weighted += ranking.value[from + j] * ALBUM_WEIGHTS[count + j];
+    weighted += (ranking.prefix[from + open] - ranking.prefix[from + j]) *
+                ALBUM_TAIL_WEIGHT;
+    return weighted;
+  }
+
+  // Ranks from 'r' on with a quality of at least 'threshold'.
+  size_t RanksAbove(size_t r, double threshold) const {
+    auto first = ranking.value.begin() + static_cast<ptrdiff_t>(r);
+    auto end = std::partition_point(
+        first, ranking.value.end(),
+        [threshold](double q) { return q >= threshold; });
+    return static_cast<size_t>(end - first);
+  }
+
+  void Descend(size_t r) {
+    if (count == k) {
+      Evaluate();
+      return;
+    }
+    if (++nodes % DEADLINE_CHECK == 0 && Clock::now() >= deadline.end)
+      deadline.expired.store(true, std::memory_order_relaxed);
+
+    const size_t n = ranking.value.size();
+    while (r + (k - count) <= n &&
+           !deadline.expired.load(std::memory_order_relaxed)) {
+      // The bound only falls as r grows, so the first miss ends the level
+      if (!Promising(best, Bound(r)))
+        return;
+
+      // Take rank r, then try the tracklists that skip its whole value
+      // group (taking a later equal rank instead would repeat them)
+      Push(r);
+      Descend(r + 1);
+      Pop();
+      r = ranking.nextValue[r];
+    }
+  }
+
+  void Evaluate() {
+    AlbumStats stats;
+    stats.count = k;
+    stats.sum = sum; // Added best first, as CalcAlbumQuality does
+    stats.sumSquares = sumSquares;
+    size_t head = std::min(k, ALBUM_HEAD);
+    for (size_t p = 0; p < head; ++p)
+      stats.head[p] = ranking.value[picks[p]];
+
+    double quality = AlbumQuality(stats, [this](double threshold) {
+      size_t below = 0; // A suffix of the picks
+      for (size_t p = k; p-- > 0 && ranking.value[picks[p]] < threshold;)
+        ++below;
+      return below;
+    });
+    if (quality > Best())
+      best.Offer(quality, picks.data(), k);
+  }
+
+  void Push(size_t r) {
+    double q = ranking.value[r];
+    saved[count] = {headWeighted, tailSum, sum, sumSquares};
+    if (count < ALBUM_HEAD)
+      headWeighted += q * ALBUM_WEIGHTS[count];
+    else
+      tailSum += q;
+    sum += q;
+    sumSquares += q * q;
+    picks[count++] = static_cast<uint32_t>(r);
+  }
+
+  void Pop() {
+    --count;
+    const Sums &s = saved[count];
+    headWeighted = s.headWeighted;
+    tailSum = s.tailSum;
+    sum = s.sum;
+    sumSquares = s.sumSquares;
+  }
+
+  struct Sums {
+    double headWeighted, tailSum, sum, sumSquares;
+  };
+
+  const Ranking &ranking;
+  const size_t k;
+  Incumbent &best;
+  Deadline &deadline;
+  double totalWeight = 0.0;
+
+  // Current picks (ranks) and their running sums; restored exactly on Pop
+  std::array<uint32_t, TRACKLIST_MAX_TRACKS> picks{};
+  std::array<Sums, TRACKLIST_MAX_TRACKS> saved{};
+  size_t count = 0;
+  double headWeighted = 0.0; // Picks in head spots, weighted
+  double tailSum = 0.0;      // Picks past the head
+  double sum = 0.0;
+  double sumSquares = 0.0;
+  uint64_t nodes = 0;
+};
+
+} // namespace
+
+TracklistResult FindBestTracklist(const std::vector<double> &qualities,
+                                  const TracklistOptions &options) {
+  TracklistResult result;
+  const size_t n = qualities.size();
+  const size_t minTracks = std::max<size_t>(options.minTracks, 1);
+  const size_t maxTracks =
+      std::min({options.maxTracks, TRACKLIST_MAX_TRACKS, n});
+  if (minTracks > maxTracks)
+    return result;
+
+  // 1. Rank the candidates once (ties: lower candidate first)
+  Ranking ranking;
+  ranking.candidate.resize(n);
+  std::iota(ranking.candidate.begin(), ranking.candidate.end(), 0u);
+  std::sort(ranking.candidate.begin(), ranking.candidate.end(),
+            [&](uint32_t a, uint32_t b) {
+              if (qualities[a] != qualities[b])
+                return qualities[a] > qualities[b];
+              return a < b;
+            });
+  ranking.value.resize(n);
+  ranking.prefix.assign(n + 1, 0.0);
+  for (size_t r = 0; r < n; ++r) {
+    ranking.value[r] = qualities[ranking.candidate[r]];
+    ranking.prefix[r + 1] = ranking.prefix[r] + ranking.value[r];
+  }
+  ranking.nextValue.resize(n);
+  for (size_t r = n; r-- > 0;) {
+    bool same = r + 1 < n && ranking.value[r + 1] == ranking.value[r];
+    ranking.nextValue[r] =
+        same ? ranking.nextValue[r + 1] : static_cast<uint32_t>(r + 1);
+  }
+
+  // First pick of every value group (the only first picks worth trying)
+  std::vector<uint32_t> firsts;
+  for (size_t r = 0; r < n; r = ranking.nextValue[r])
+    firsts.push_back(static_cast<uint32_t>(r));
+
+  Incumbent best;
+  Deadline deadline;
+  deadline.end = Clock::now() +
+                 std::chrono::duration_cast<Clock::duration>(
+                     std::chrono::duration<double, std::milli>(
+                         options.budgetMs));
+
+  // 2. Start from the best top-k album, then search the most promising
+  // sizes first: a strong early incumbent prunes the rest
+  std::vector<size_t> sizes;
+  std::vector<double> sizeBound(maxTracks + 1, 0.0);
+  for (size_t k = minTracks; k <= maxTracks; ++k) {
+    SizeSearch search(ranking, k, best, deadline);
+    search.Greedy();
+    sizes.push_back(k);
+    sizeBound[k] = search.Bound(0);
+  }
+  std::stable_sort(sizes.begin(), sizes.end(), [&](size_t a, size_t b) {
+    return sizeBound[a] > sizeBound[b];
+  });
+
+  // 3. Search each size, first picks spread across the pool
+  ThreadPool &pool = SharedThreadPool();
+  std::atomic<uint64_t> nodes{0};
+  for (size_t k : sizes) {
+    if (deadline.expired.load() ||
+        !Promising(best, sizeBound[k]))
+      continue;
+
+    std::atomic<size_t> nextFirst{0};
+    std::atomic<bool> exhausted{false};
+    pool.ParallelFor(pool.Size(), [&](size_t) {
+      SizeSearch search(ranking, k, best, deadline);
+      while (!exhausted.load(std::memory_order_relaxed) &&
+             !deadline.expired.load(std::memory_order_relaxed)) {
+        size_t i = nextFirst.fetch_add(1, std::memory_order_relaxed);
+        // Bounds only fall with the first pick: one miss ends the size
+        if (i >= firsts.size() || !search.CanStart(firsts[i])) {
+          exhausted.store(true, std::memory_order_relaxed);
+          break;
+        }
+        search.SearchFrom(firsts[i]);
+      }
+      nodes.fetch_add(search.Nodes(), std::memory_order_relaxed);
+    });
+  }
+
+  // 4. Back to candidate indices; the quality reported is the reference's
+  // (the search's own sums round differently)
+  std::vector<double> sortedSongs;
+  for (uint32_t r : best.ranks) {
+    result.tracks.push_back(ranking.candidate[r]);
+    sortedSongs.push_back(ranking.value[r]);
+  }
+  result.quality = AlbumQualityOfSorted(sortedSongs);
+  result.exact = !deadline.expired.load();
+  result.nodes = nodes.load();
+  return result;
+}
@@ -0,0 +1,195 @@
+#include "../headers/world.h"
+#include "../headers/config.h"
+#include "../headers/helper.h"
+#include "../headers/stringpool.h"
+#include "../headers/telemetry.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+World::World(uint64_t worldSeed, std::string artist)
+    : seed(worldSeed), player(std::move(artist)),
+      rng(worldSeed, RngStream::Session) {
+  economy.seed = worldSeed;
+}
+
+void StepWorld(World &world, float dt) {
+  // Anything the tick draws through Random:: stays on this world's streams
+  Random::StreamScope scope(world.rng);
+
+  SimulateEconomy(world.economy, world.songs, world.albums, world.player, dt,
+                  *world.clock, world.log, world.mode);
+  UpdateReputation(world.player, world.songs, world.albums, world.clock,
+                   world.economy.telemetry);
+
+  world.songs.RemoveExpired(EconomyConfig::SONG_LIFETIME);
+  world.albums.RemoveExpired(EconomyConfig::ALBUM_LIFETIME);
+}
+
+void FastForwardWorld(World &world, uint64_t ticks) {
+  constexpr float TICK = EconomyConfig::ECONOMY_TICK_RATE;
+  Random::StreamScope scope(world.rng);
+
+  // Most refusals are read off a few columns, but one that gets as far as
+  // evaluating spans costs several ticks' worth of work over the whole
+  // catalog; a busy catalog refuses again and again. So after each refusal
+  // step twice as long before asking again (at most a little over a year)
+  constexpr uint64_t MAX_BACKOFF = 512;
+  uint64_t backoff = 1;
+
+  while (ticks > 0) {
+    float clock = *world.clock;
+    uint64_t span = FastForwardEconomy(world.economy, world.songs, world.albums,
+                                       world.player, ticks, *world.clock);
+    if (span == 0) {
+      for (uint64_t t = 0; t < backoff && ticks > 0; ++t, --ticks)
+        StepWorld(world, TICK);
+      backoff = std::min(backoff * 2, MAX_BACKOFF);
+      continue;
+    }
+    backoff = 1;
+
+    // UpdateReputation would have run after every tick of the span: replay
+    // its accumulator against the same clock values
+    bool cycled = false;
+    for (uint64_t t = 0; t < span; ++t) {
+      clock += TICK;
+      world.player.repUpdateAccumulator += clock;
+      if (world.player.repUpdateAccumulator >= EconomyConfig::REP_CYCLE) {
+        world.player.repUpdateAccumulator -= EconomyConfig::REP_CYCLE;
+        cycled = true;
+      }
+    }
+    if (cycled) {
+      world.player.reputation = CatalogReputation(world.songs, world.albums);
+      if (world.economy.telemetry)
+        world.economy.telemetry->NoteReputation(world.player.reputation);
+    }
+
+    world.songs.RemoveExpired(EconomyConfig::SONG_LIFETIME);
+    world.albums.RemoveExpired(EconomyConfig::ALBUM_LIFETIME);
+    ticks -= span;
+  }
+}
+
+namespace {
+void Log(World &world, LogMessage id, const LogArgs &args = {}) {
+  if (world.log)
+    world.log->Add(id, args);
+}
+} // namespace
+
+bool RecordSong(World &world, const std::string &name, Genre genre) {
+  Player &player = world.player;
+  double recordedQuality = player.CalcQuality();
+  if (player.Energy < 5.0) {
+    Log(world, LogMessage::NoEnergyToRecord);
+    return false;
+  }
+
+  player.Energy -= 5.0;
+  world.vault.Insert(Song(name, player.name, genre, recordedQuality,
+                          player.fans,
+                          GetRecommendedPrice(recordedQuality, false)));
+
+  Log(world, LogMessage::Recorded,
+      {.number = static_cast<int>(recordedQuality),
+       .genre = genre,
+       .text = name});
+  return true;
+}
+
+bool ReleaseSingle(World &world, SlotHandle song) {
+  const Song *single = world.vault.Get(song);
+  if (!single) {
+    Log(world, LogMessage::VaultChanged);
+    return false;
+  }
+
+  world.songs.Add(*single);
+  Log(world, LogMessage::ReleasedSingle,
+      {.text = stringPool.View(single->name)});
+  world.vault.Erase(song);
+  return true;
+}
+
+bool ReleaseAlbum(World &world, const std::string &name,
+                  const std::vector<SlotHandle> &tracks) {
+  if (tracks.empty())
+    return false;
+
+  // Every track must still be in the vault, and only once
+  std::vector<uint32_t> slots;
+  slots.reserve(tracks.size());
+  for (SlotHandle track : tracks) {
+    if (!world.vault.Contains(track)) {
+      Log(world, LogMessage::VaultChanged);
+      return false;
+    }
+    slots.push_back(track.index);
+  }
+  std::sort(slots.begin(), slots.end());
+  if (std::adjacent_find(slots.begin(), slots.end()) != slots.end())
+    return false;
+
+  Player &player = world.player;
+  if (player.Energy < 10.0) {
+    Log(world, LogMessage::NoEnergyToRelease);
+    return false;
+  }
+  player.Energy -= 10.0;
+
+  // 1. Move the tracks out of the vault (O(1) each)
+  std::vector<Song> albumTracks;
+  std::vector<double> qualities;
+  std::vector<Genre> genres;
+  albumTracks.reserve(tracks.size());
+  for (SlotHandle track : tracks) {
+    const Song &song = *world.vault.Get(track);
+    albumTracks.push_back(song);
+    qualities.push_back(song.quality);
+    genres.push_back(song.genre);
+    world.vault.Erase(track);
+  }
+
+  // 2. Create the Album (genre = most used among the tracks)
+  double quality = player.CalcAlbumQuality(qualities);
+  size_t trackCount = albumTracks.size();
+  world.albums.Add(Album(name, player.name, GetAlbumGenre(genres),
+                         std::move(albumTracks), quality, player.fans,
+                         GetRecommendedPrice(quality, true)));
+
+  // 3. Log it
+  Log(world, trackCount < 6 ? LogMessage::ReleasedEP : LogMessage::ReleasedLP,
+      {.text = name});
+  return true;
+}
+
+bool BuyUpgrade(World &world, bool skill, size_t index, double cost,
+                double gain) {
+  Player &player = world.player;
+  if (index >= (skill ? SKILL_COUNT : TOOL_COUNT) || player.money < cost)
+    return false;
+
+  player.money -= cost;
+  if (skill) {
+    Skill id = static_cast<Skill>(index);
+    player.SetSkillLevel(id, player.SkillLevel(id) + gain);
+  } else {
+    Tool id = static_cast<Tool>(index);
+    player.SetToolLevel(id, player.ToolLevel(id) + gain);
+  }
+
+  // Free study is silent
+  if (cost > 0.0) {
+    if (skill)
+      Log(world, LogMessage::Learned, {.text = SKILL_NAMES[index]});
+    else
+      Log(world, LogMessage::Upgraded);
+  }
+  return true;
+}